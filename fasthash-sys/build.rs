@@ -29,6 +29,13 @@ fn has_sse42() -> bool {
             .map_or(false, |features| features.has_sse42())
 }
 
+fn has_pclmulqdq() -> bool {
+    cfg!(feature = "native")
+        && CPUID
+            .get_feature_info()
+            .map_or(false, |features| features.has_pclmulqdq())
+}
+
 fn has_avx() -> bool {
     cfg!(feature = "native")
         && CPUID
@@ -55,6 +62,10 @@ fn support_sse42() -> bool {
     cfg!(any(feature = "sse42", target_feature = "sse42")) || has_sse42()
 }
 
+fn support_pclmulqdq() -> bool {
+    cfg!(any(feature = "pclmul", target_feature = "pclmulqdq")) || has_pclmulqdq()
+}
+
 fn support_avx() -> bool {
     cfg!(any(feature = "avx", target_feature = "avx")) || has_avx()
 }
@@ -105,6 +116,10 @@ fn generate_binding(out_file: &Path) {
         .blacklist_function("^t1ha_selfcheck__.*")
         .whitelist_function("^XXH.*")
         .whitelist_function("^HighwayHash.*")
+        .whitelist_function("^crc32c.*")
+        .whitelist_function("^aeshash.*")
+        .whitelist_function("^wyhash.*")
+        .whitelist_function("^rapidhash.*")
         .generate()
         .unwrap()
         .write_to_file(out_file)
@@ -126,6 +141,7 @@ fn build_fasthash() {
         .flag("-Wno-unknown-attributes")
         .include("src/highwayhash")
         .file("src/fasthash.cpp")
+        .file("src/fasthash_fixed.cpp")
         .file("src/smhasher/City.cpp")
         .file("src/smhasher/farmhash-c.c")
         .file("src/smhasher/lookup3.cpp")
@@ -143,11 +159,59 @@ fn build_fasthash() {
             .flag("-msse4.2")
             .file("src/smhasher/metrohash64crc.cpp")
             .file("src/smhasher/metrohash128crc.cpp");
+
+        if support_pclmulqdq() {
+            build.flag("-mpclmul");
+        }
+    }
+
+    // aeshash checks for AES-NI at runtime unless it is known at compile time
+    if support_aesni() {
+        build.flag("-maes");
+    }
+
+    // the streaming HighwayHash state uses the best target enabled at compile time
+    if support_avx2() {
+        build.flag("-mavx2");
+    }
+
+    if cfg!(any(target_arch = "x86", target_arch = "x86_64")) {
+        build.define("FASTHASH_XXH3_DISPATCH", None);
     }
 
     build.static_flag(true).compile("fasthash");
 }
 
+// XXH3 spends nearly all of its time on large inputs in one accumulate loop,
+// so xxhash.c is compiled once per instruction set under its own namespace
+// and `fasthash.cpp` picks the widest one the CPU supports at runtime.
+//
+// The bundled xxHash has no AVX-512 accumulate loop, so `-mavx512f` would only
+// build the AVX2 one again with EVEX encodings.
+fn build_xxh3_kernels() {
+    let kernels = [
+        ("scalar", None),
+        ("sse2", Some("-msse2")),
+        ("avx2", Some("-mavx2")),
+    ];
+
+    for &(name, flag) in &kernels {
+        let mut build = cc::Build::new();
+
+        build.file("src/xxHash/xxhash.c").define(
+            "XXH_NAMESPACE",
+            Some(format!("fasthash_{}_", name).as_str()),
+        );
+
+        match flag {
+            Some(flag) => build.flag(flag),
+            None => build.define("XXH_VECTOR", Some("0")),
+        };
+
+        build.static_flag(true).compile(&format!("xxh3_{}", name));
+    }
+}
+
 fn build_t1() {
     let mut build = cc::Build::new();
 
@@ -220,6 +284,9 @@ fn main() {
     if has_sse42() {
         println!(r#"cargo:rustc-cfg=feature="sse42""#);
     }
+    if has_pclmulqdq() {
+        println!(r#"cargo:rustc-cfg=feature="pclmul""#);
+    }
     if has_avx() {
         println!(r#"cargo:rustc-cfg=feature="avx""#);
     }
@@ -228,6 +295,9 @@ fn main() {
     }
 
     build_fasthash();
+    if cfg!(any(target_arch = "x86", target_arch = "x86_64")) {
+        build_xxh3_kernels();
+    }
     if cfg!(feature = "t1ha") {
         build_t1();
     }
@@ -238,6 +308,7 @@ fn main() {
 
     println!("cargo:rerun-if-changed=src/fasthash.hpp");
     println!("cargo:rerun-if-changed=src/fasthash.cpp");
+    println!("cargo:rerun-if-changed=src/fasthash_fixed.cpp");
 
     generate_binding(&out_file);
 }
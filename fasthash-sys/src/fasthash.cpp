@@ -1,8 +1,32 @@
 #include "fasthash.hpp"
 
+#include <string.h>
+
+#include <new>
+
+#include "highwayhash/highwayhash.h"
 #include "highwayhash/highwayhash_target.h"
 #include "highwayhash/instruction_sets.h"
 
+#if defined(__SSE4_2__) && defined(__x86_64__)
+#include <nmmintrin.h>
+#define CRC32C_HW 1
+#endif
+
+#if defined(CRC32C_HW) && defined(__PCLMUL__)
+#include <wmmintrin.h>
+#define CRC32C_PCLMUL 1
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <wmmintrin.h>
+#define AESHASH_NI 1
+#define AESHASH_TARGET __attribute__((target("aes,sse2")))
+#else
+#define AESHASH_TARGET
+#endif
+
 uint64_t farmhash_fingerprint_uint128(uint128_c_t x)
 {
     return farmhash_fingerprint_uint128_c_t(x);
@@ -69,3 +93,973 @@ void HighwayHash256(const HHKey key, const char* bytes, const uint64_t size, HHR
     highwayhash::InstructionSets::Run<highwayhash::HighwayHash>(
         *reinterpret_cast<const HHKey*>(key), bytes, size, reinterpret_cast<HHResult256*>(hash));
 }
+
+// The streaming state uses the best target enabled at compile time
+typedef highwayhash::HighwayHashCatT<HH_TARGET> HighwayHashCatImpl;
+
+static_assert(sizeof(HighwayHashCatImpl) <= sizeof(HighwayHashCat), "HighwayHashCat is too small");
+static_assert(alignof(HighwayHashCatImpl) <= alignof(HighwayHashCat), "HighwayHashCat is under-aligned");
+
+void HighwayHashCatStart(const HHKey key, HighwayHashCat *state) {
+    new (state->state) HighwayHashCatImpl(*reinterpret_cast<const HHKey*>(key));
+}
+
+void HighwayHashCatAppend(const char* bytes, const uint64_t size, HighwayHashCat *state) {
+    reinterpret_cast<HighwayHashCatImpl*>(state->state)->Append(bytes, size);
+}
+
+// Finalize on a copy, so the state can keep growing after a digest
+template <typename Result>
+static void HighwayHashCatFinish(const HighwayHashCat *state, Result *hash) {
+    HighwayHashCat copy = *state;
+
+    reinterpret_cast<HighwayHashCatImpl*>(copy.state)->Finalize(hash);
+}
+
+uint64_t HighwayHashCatFinish64(const HighwayHashCat *state) {
+    highwayhash::HHResult64 hash;
+
+    HighwayHashCatFinish(state, &hash);
+
+    return hash;
+}
+
+void HighwayHashCatFinish128(const HighwayHashCat *state, HHResult128& hash) {
+    HighwayHashCatFinish(state, reinterpret_cast<highwayhash::HHResult128*>(hash));
+}
+
+void HighwayHashCatFinish256(const HighwayHashCat *state, HHResult256& hash) {
+    HighwayHashCatFinish(state, reinterpret_cast<highwayhash::HHResult256*>(hash));
+}
+
+// CRC-32C (Castagnoli), reflected polynomial
+static const uint32_t CRC32C_POLY = 0x82F63B78;
+
+struct Crc32cTables
+{
+    uint32_t slice[8][256];
+    uint32_t x2n[32]; // x^(2^n) mod P(x)
+
+    Crc32cTables()
+    {
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t crc = n;
+
+            for (int k = 0; k < 8; k++)
+                crc = crc & 1 ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+
+            slice[0][n] = crc;
+        }
+
+        for (uint32_t n = 0; n < 256; n++)
+            for (int k = 1; k < 8; k++)
+                slice[k][n] = (slice[k - 1][n] >> 8) ^ slice[0][slice[k - 1][n] & 0xFF];
+
+        x2n[0] = 1u << 30; // x^1
+        for (int n = 1; n < 32; n++)
+            x2n[n] = multmodp(x2n[n - 1], x2n[n - 1]);
+    }
+
+    // a(x) * b(x) mod P(x), bit-reflected
+    static uint32_t multmodp(uint32_t a, uint32_t b)
+    {
+        uint32_t m = 1u << 31, p = 0;
+
+        for (;;)
+        {
+            if (a & m)
+            {
+                p ^= b;
+                if ((a & (m - 1)) == 0)
+                    break;
+            }
+            m >>= 1;
+            b = b & 1 ? (b >> 1) ^ CRC32C_POLY : b >> 1;
+        }
+
+        return p;
+    }
+
+    // x^(n * 2^k) mod P(x)
+    uint32_t x2nmodp(uint64_t n, unsigned k) const
+    {
+        uint32_t p = 1u << 31; // x^0
+
+        while (n)
+        {
+            if (n & 1)
+                p = multmodp(x2n[k & 31], p);
+            n >>= 1;
+            k++;
+        }
+
+        return p;
+    }
+};
+
+static const Crc32cTables &crc32c_tables()
+{
+    static const Crc32cTables tables;
+
+    return tables;
+}
+
+static inline uint64_t crc32c_load64(const uint8_t *p)
+{
+    uint64_t v;
+
+    memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+#if defined(CRC32C_HW)
+
+// Each of the three interleaved streams is this long, so that the 3-cycle
+// latency of the crc32 instruction is hidden behind the other two streams.
+static const size_t CRC32C_LONG = 8192;
+static const size_t CRC32C_SHORT = 256;
+
+// Shifts a CRC by a fixed number of zero bytes, c(x) * x^(8 * len) mod P(x)
+struct Crc32cShift
+{
+#if defined(CRC32C_PCLMUL)
+    // The carry-less product of two reflected 32-bit values is reflected over 63 bits,
+    // and crc32 multiplies by a further x^32, so the constant is x^(8 * len - 33).
+    uint64_t k;
+
+    explicit Crc32cShift(size_t len) : k(crc32c_tables().x2nmodp(8 * len - 33, 0)) {}
+
+    inline uint32_t operator()(uint32_t crc) const
+    {
+        __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(crc), _mm_cvtsi64_si128(k), 0);
+
+        return static_cast<uint32_t>(_mm_crc32_u64(0, _mm_cvtsi128_si64(product)));
+    }
+#else
+    uint32_t table[4][256];
+
+    explicit Crc32cShift(size_t len)
+    {
+        uint32_t k = crc32c_tables().x2nmodp(len, 3);
+
+        for (int i = 0; i < 4; i++)
+            for (uint32_t n = 0; n < 256; n++)
+                table[i][n] = Crc32cTables::multmodp(k, n << (8 * i));
+    }
+
+    inline uint32_t operator()(uint32_t crc) const
+    {
+        return table[0][crc & 0xFF] ^
+               table[1][(crc >> 8) & 0xFF] ^
+               table[2][(crc >> 16) & 0xFF] ^
+               table[3][crc >> 24];
+    }
+#endif
+};
+
+struct Crc32cShifts
+{
+    Crc32cShift long1, long2, short1, short2;
+
+    Crc32cShifts()
+        : long1(CRC32C_LONG), long2(2 * CRC32C_LONG), short1(CRC32C_SHORT), short2(2 * CRC32C_SHORT) {}
+};
+
+static const Crc32cShifts &crc32c_shifts()
+{
+    static const Crc32cShifts shifts;
+
+    return shifts;
+}
+
+// CRC of 3 * n bytes as three interleaved streams, joined by shifting the first two
+static inline uint64_t crc32c_3way(uint64_t crc0, const uint8_t *p, size_t n,
+                                   const Crc32cShift &shift1, const Crc32cShift &shift2)
+{
+    uint64_t crc1 = 0, crc2 = 0;
+    const uint8_t *end = p + n;
+
+    do
+    {
+        crc0 = _mm_crc32_u64(crc0, crc32c_load64(p));
+        crc1 = _mm_crc32_u64(crc1, crc32c_load64(p + n));
+        crc2 = _mm_crc32_u64(crc2, crc32c_load64(p + 2 * n));
+        p += 8;
+    } while (p < end);
+
+    return shift2(static_cast<uint32_t>(crc0)) ^ shift1(static_cast<uint32_t>(crc1)) ^ crc2;
+}
+
+static uint32_t crc32c_hw(uint32_t crc, const uint8_t *p, size_t len)
+{
+    uint64_t crc64 = crc;
+
+    for (; len && (reinterpret_cast<uintptr_t>(p) & 7); len--)
+        crc64 = _mm_crc32_u8(static_cast<uint32_t>(crc64), *p++);
+
+    if (len >= 3 * CRC32C_SHORT)
+    {
+        const Crc32cShifts &shifts = crc32c_shifts();
+
+        for (; len >= 3 * CRC32C_LONG; len -= 3 * CRC32C_LONG, p += 3 * CRC32C_LONG)
+            crc64 = crc32c_3way(crc64, p, CRC32C_LONG, shifts.long1, shifts.long2);
+
+        for (; len >= 3 * CRC32C_SHORT; len -= 3 * CRC32C_SHORT, p += 3 * CRC32C_SHORT)
+            crc64 = crc32c_3way(crc64, p, CRC32C_SHORT, shifts.short1, shifts.short2);
+    }
+
+    for (; len >= 8; len -= 8, p += 8)
+        crc64 = _mm_crc32_u64(crc64, crc32c_load64(p));
+
+    for (; len; len--)
+        crc64 = _mm_crc32_u8(static_cast<uint32_t>(crc64), *p++);
+
+    return static_cast<uint32_t>(crc64);
+}
+
+#else
+
+static uint32_t crc32c_sw(uint32_t crc, const uint8_t *p, size_t len)
+{
+    const Crc32cTables &t = crc32c_tables();
+
+    for (; len && (reinterpret_cast<uintptr_t>(p) & 7); len--)
+        crc = (crc >> 8) ^ t.slice[0][(crc ^ *p++) & 0xFF];
+
+    for (; len >= 8; len -= 8, p += 8)
+    {
+        uint64_t v = crc32c_load64(p) ^ crc;
+
+        crc = t.slice[7][v & 0xFF] ^
+              t.slice[6][(v >> 8) & 0xFF] ^
+              t.slice[5][(v >> 16) & 0xFF] ^
+              t.slice[4][(v >> 24) & 0xFF] ^
+              t.slice[3][(v >> 32) & 0xFF] ^
+              t.slice[2][(v >> 40) & 0xFF] ^
+              t.slice[1][(v >> 48) & 0xFF] ^
+              t.slice[0][v >> 56];
+    }
+
+    for (; len; len--)
+        crc = (crc >> 8) ^ t.slice[0][(crc ^ *p++) & 0xFF];
+
+    return crc;
+}
+
+#endif
+
+uint32_t crc32c_update(uint32_t crc, const void *data, size_t len)
+{
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+
+#if defined(CRC32C_HW)
+    return ~crc32c_hw(~crc, p, len);
+#else
+    return ~crc32c_sw(~crc, p, len);
+#endif
+}
+
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+    const Crc32cTables &t = crc32c_tables();
+
+    return Crc32cTables::multmodp(t.x2nmodp(len2, 3), crc1) ^ crc2;
+}
+
+// XXH3 kernels compiled once per x86 instruction set and selected at runtime
+
+// Inputs up to this size are hashed without touching the vector accumulate loop.
+static const size_t XXH3_DISPATCH_MIN = 240;
+
+struct Xxh3Kernel
+{
+    XXH64_hash_t (*hash64)(const void *, size_t);
+    XXH64_hash_t (*hash64_withSeed)(const void *, size_t, XXH64_hash_t);
+    XXH64_hash_t (*hash64_withSecret)(const void *, size_t, const void *, size_t);
+    XXH_errorcode (*update64)(XXH3_state_t *, const void *, size_t);
+    XXH128_hash_t (*hash128)(const void *, size_t);
+    XXH128_hash_t (*hash128_withSeed)(const void *, size_t, XXH64_hash_t);
+    XXH128_hash_t (*hash128_withSecret)(const void *, size_t, const void *, size_t);
+    XXH_errorcode (*update128)(XXH3_state_t *, const void *, size_t);
+};
+
+#define XXH3_KERNEL(prefix)                                                                               \
+    {                                                                                                     \
+        prefix##XXH3_64bits, prefix##XXH3_64bits_withSeed, prefix##XXH3_64bits_withSecret,               \
+            prefix##XXH3_64bits_update, prefix##XXH3_128bits, prefix##XXH3_128bits_withSeed,             \
+            prefix##XXH3_128bits_withSecret, prefix##XXH3_128bits_update                                  \
+    }
+
+#if defined(FASTHASH_XXH3_DISPATCH)
+
+// xxhash.c is built again for each instruction set with XXH_NAMESPACE set to the prefix
+#define XXH3_KERNEL_DECLARE(prefix)                                                                       \
+    extern "C"                                                                                            \
+    {                                                                                                     \
+        XXH64_hash_t prefix##XXH3_64bits(const void *data, size_t len);                                   \
+        XXH64_hash_t prefix##XXH3_64bits_withSeed(const void *data, size_t len, XXH64_hash_t seed);       \
+        XXH64_hash_t prefix##XXH3_64bits_withSecret(const void *data, size_t len,                         \
+                                                    const void *secret, size_t secretSize);               \
+        XXH_errorcode prefix##XXH3_64bits_update(XXH3_state_t *state, const void *input, size_t len);     \
+        XXH128_hash_t prefix##XXH3_128bits(const void *data, size_t len);                                 \
+        XXH128_hash_t prefix##XXH3_128bits_withSeed(const void *data, size_t len, XXH64_hash_t seed);     \
+        XXH128_hash_t prefix##XXH3_128bits_withSecret(const void *data, size_t len,                       \
+                                                      const void *secret, size_t secretSize);             \
+        XXH_errorcode prefix##XXH3_128bits_update(XXH3_state_t *state, const void *input, size_t len);    \
+    }
+
+XXH3_KERNEL_DECLARE(fasthash_scalar_)
+XXH3_KERNEL_DECLARE(fasthash_sse2_)
+XXH3_KERNEL_DECLARE(fasthash_avx2_)
+
+// indexed by XXH3_kernel
+static const Xxh3Kernel XXH3_KERNELS[] = {
+    XXH3_KERNEL(fasthash_scalar_),
+    XXH3_KERNEL(fasthash_sse2_),
+    XXH3_KERNEL(fasthash_avx2_),
+};
+
+bool XXH3_kernel_supported(XXH3_kernel kernel)
+{
+    __builtin_cpu_init();
+
+    // __builtin_cpu_supports also checks that the OS saves the wider registers
+    switch (kernel)
+    {
+    case XXH3_KERNEL_SCALAR:
+        return true;
+    case XXH3_KERNEL_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case XXH3_KERNEL_AVX2:
+        return __builtin_cpu_supports("avx2");
+    }
+
+    return false;
+}
+
+static XXH3_kernel xxh3_select_kernel()
+{
+    if (XXH3_kernel_supported(XXH3_KERNEL_AVX2))
+        return XXH3_KERNEL_AVX2;
+    if (XXH3_kernel_supported(XXH3_KERNEL_SSE2))
+        return XXH3_KERNEL_SSE2;
+
+    return XXH3_KERNEL_SCALAR;
+}
+
+#else
+
+// without runtime selection, every kernel is the default build
+static const Xxh3Kernel XXH3_KERNELS[] = {
+    XXH3_KERNEL(),
+    XXH3_KERNEL(),
+    XXH3_KERNEL(),
+};
+
+bool XXH3_kernel_supported(XXH3_kernel)
+{
+    return false;
+}
+
+static XXH3_kernel xxh3_select_kernel()
+{
+    return XXH3_KERNEL_SCALAR;
+}
+
+#endif
+
+static const Xxh3Kernel &xxh3_kernel()
+{
+    static const Xxh3Kernel &kernel = XXH3_KERNELS[xxh3_select_kernel()];
+
+    return kernel;
+}
+
+XXH64_hash_t XXH3_64bits_dispatch(const void *data, size_t len)
+{
+    if (len <= XXH3_DISPATCH_MIN)
+        return XXH3_64bits(data, len);
+
+    return xxh3_kernel().hash64(data, len);
+}
+
+XXH64_hash_t XXH3_64bits_withSeed_dispatch(const void *data, size_t len, XXH64_hash_t seed)
+{
+    if (len <= XXH3_DISPATCH_MIN)
+        return XXH3_64bits_withSeed(data, len, seed);
+
+    return xxh3_kernel().hash64_withSeed(data, len, seed);
+}
+
+XXH64_hash_t XXH3_64bits_withSecret_dispatch(const void *data, size_t len, const void *secret, size_t secretSize)
+{
+    if (len <= XXH3_DISPATCH_MIN)
+        return XXH3_64bits_withSecret(data, len, secret, secretSize);
+
+    return xxh3_kernel().hash64_withSecret(data, len, secret, secretSize);
+}
+
+XXH_errorcode XXH3_64bits_update_dispatch(XXH3_state_t *state, const void *input, size_t len)
+{
+    return xxh3_kernel().update64(state, input, len);
+}
+
+XXH128_hash_t XXH3_128bits_dispatch(const void *data, size_t len)
+{
+    if (len <= XXH3_DISPATCH_MIN)
+        return XXH3_128bits(data, len);
+
+    return xxh3_kernel().hash128(data, len);
+}
+
+XXH128_hash_t XXH3_128bits_withSeed_dispatch(const void *data, size_t len, XXH64_hash_t seed)
+{
+    if (len <= XXH3_DISPATCH_MIN)
+        return XXH3_128bits_withSeed(data, len, seed);
+
+    return xxh3_kernel().hash128_withSeed(data, len, seed);
+}
+
+XXH128_hash_t XXH3_128bits_withSecret_dispatch(const void *data, size_t len, const void *secret, size_t secretSize)
+{
+    if (len <= XXH3_DISPATCH_MIN)
+        return XXH3_128bits_withSecret(data, len, secret, secretSize);
+
+    return xxh3_kernel().hash128_withSecret(data, len, secret, secretSize);
+}
+
+XXH_errorcode XXH3_128bits_update_dispatch(XXH3_state_t *state, const void *input, size_t len)
+{
+    return xxh3_kernel().update128(state, input, len);
+}
+
+// One kernel, which must be supported by the CPU, for comparing the kernels with each other
+
+XXH64_hash_t XXH3_64bits_withSeed_kernel(XXH3_kernel kernel, const void *data, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_KERNELS[kernel].hash64_withSeed(data, len, seed);
+}
+
+XXH64_hash_t XXH3_64bits_withSecret_kernel(XXH3_kernel kernel, const void *data, size_t len, const void *secret, size_t secretSize)
+{
+    return XXH3_KERNELS[kernel].hash64_withSecret(data, len, secret, secretSize);
+}
+
+XXH_errorcode XXH3_64bits_update_kernel(XXH3_kernel kernel, XXH3_state_t *state, const void *input, size_t len)
+{
+    return XXH3_KERNELS[kernel].update64(state, input, len);
+}
+
+XXH128_hash_t XXH3_128bits_withSeed_kernel(XXH3_kernel kernel, const void *data, size_t len, XXH64_hash_t seed)
+{
+    return XXH3_KERNELS[kernel].hash128_withSeed(data, len, seed);
+}
+
+XXH128_hash_t XXH3_128bits_withSecret_kernel(XXH3_kernel kernel, const void *data, size_t len, const void *secret, size_t secretSize)
+{
+    return XXH3_KERNELS[kernel].hash128_withSecret(data, len, secret, secretSize);
+}
+
+XXH_errorcode XXH3_128bits_update_kernel(XXH3_kernel kernel, XXH3_state_t *state, const void *input, size_t len)
+{
+    return XXH3_KERNELS[kernel].update128(state, input, len);
+}
+
+// Little-endian loads, so that a hash does not depend on the byte order
+static inline uint64_t read64_le(const uint8_t *p)
+{
+    uint64_t v;
+
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+
+    return v;
+}
+
+static inline uint64_t read32_le(const uint8_t *p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+
+    return v;
+}
+
+// AES short-key hash, built from single AES encryption rounds
+
+static const uint64_t AESHASH_KEYS[5][2] = {
+    {0x243F6A8885A308D3, 0x13198A2E03707344},
+    {0xA4093822299F31D0, 0x082EFA98EC4E6C89},
+    {0x452821E638D01377, 0xBE5466CF34E90C6C},
+    {0xC0AC29B7C97C50DD, 0x3F84D5B5B5470917},
+    {0x9216D5D98979FB1B, 0xD1310BA698DFB5AC},
+};
+
+// A software AES round with the same result as the aesenc instruction
+struct AesRoundSoft
+{
+    struct Block
+    {
+        uint8_t b[16];
+    };
+
+    static const uint8_t SBOX[256];
+
+    static inline Block make(uint64_t lo, uint64_t hi)
+    {
+        Block r;
+
+        for (int i = 0; i < 8; i++)
+        {
+            r.b[i] = (uint8_t)(lo >> (8 * i));
+            r.b[i + 8] = (uint8_t)(hi >> (8 * i));
+        }
+
+        return r;
+    }
+
+    static inline Block load(const uint8_t *p)
+    {
+        Block r;
+
+        memcpy(r.b, p, sizeof(r.b));
+
+        return r;
+    }
+
+    static inline Block xor_(const Block &a, const Block &b)
+    {
+        Block r;
+
+        for (int i = 0; i < 16; i++)
+            r.b[i] = a.b[i] ^ b.b[i];
+
+        return r;
+    }
+
+    static inline uint8_t xtime(uint8_t x)
+    {
+        return (uint8_t)((x << 1) ^ ((x >> 7) * 0x1B));
+    }
+
+    // ShiftRows, SubBytes, MixColumns and AddRoundKey
+    static inline Block enc(const Block &s, const Block &k)
+    {
+        Block r;
+
+        for (int c = 0; c < 4; c++)
+        {
+            uint8_t a0 = SBOX[s.b[4 * c]];
+            uint8_t a1 = SBOX[s.b[4 * ((c + 1) & 3) + 1]];
+            uint8_t a2 = SBOX[s.b[4 * ((c + 2) & 3) + 2]];
+            uint8_t a3 = SBOX[s.b[4 * ((c + 3) & 3) + 3]];
+            uint8_t t = a0 ^ a1 ^ a2 ^ a3;
+
+            r.b[4 * c] = a0 ^ t ^ xtime(a0 ^ a1) ^ k.b[4 * c];
+            r.b[4 * c + 1] = a1 ^ t ^ xtime(a1 ^ a2) ^ k.b[4 * c + 1];
+            r.b[4 * c + 2] = a2 ^ t ^ xtime(a2 ^ a3) ^ k.b[4 * c + 2];
+            r.b[4 * c + 3] = a3 ^ t ^ xtime(a3 ^ a0) ^ k.b[4 * c + 3];
+        }
+
+        return r;
+    }
+
+    static inline uint64_t low64(const Block &h)
+    {
+        return read64_le(h.b);
+    }
+};
+
+const uint8_t AesRoundSoft::SBOX[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+#if defined(AESHASH_NI)
+
+// The aesenc instruction, available to functions compiled for the "aes" target
+struct AesRoundNi
+{
+    typedef __m128i Block;
+
+    AESHASH_TARGET static inline Block make(uint64_t lo, uint64_t hi)
+    {
+        return _mm_set_epi64x((long long)hi, (long long)lo);
+    }
+
+    AESHASH_TARGET static inline Block load(const uint8_t *p)
+    {
+        return _mm_loadu_si128((const __m128i *)p);
+    }
+
+    AESHASH_TARGET static inline Block xor_(const Block &a, const Block &b)
+    {
+        return _mm_xor_si128(a, b);
+    }
+
+    AESHASH_TARGET static inline Block enc(const Block &s, const Block &k)
+    {
+        return _mm_aesenc_si128(s, k);
+    }
+
+    AESHASH_TARGET static inline uint64_t low64(const Block &h)
+    {
+#if defined(__x86_64__)
+        return (uint64_t)_mm_cvtsi128_si64(h);
+#else
+        uint8_t b[16];
+
+        _mm_storeu_si128((__m128i *)b, h);
+
+        return read64_le(b);
+#endif
+    }
+};
+
+#endif
+
+// Every input byte passes through at least three rounds, two of them after the
+// last block is mixed in. Inputs up to 64 bytes are read as at most four
+// overlapping blocks without a loop; the portable instantiation never emits
+// AES instructions although it shares the target attribute.
+template <typename R>
+AESHASH_TARGET static inline uint64_t aeshash(const uint8_t *p, size_t len, uint64_t seed)
+{
+    typedef typename R::Block Block;
+
+    const Block k1 = R::make(AESHASH_KEYS[1][0], AESHASH_KEYS[1][1]);
+    const Block k2 = R::make(AESHASH_KEYS[2][0], AESHASH_KEYS[2][1]);
+    const Block k3 = R::make(AESHASH_KEYS[3][0], AESHASH_KEYS[3][1]);
+    const Block k4 = R::make(AESHASH_KEYS[4][0], AESHASH_KEYS[4][1]);
+    const Block s = R::xor_(R::make(seed, (uint64_t)len), R::make(AESHASH_KEYS[0][0], AESHASH_KEYS[0][1]));
+
+    Block h;
+
+    if (len <= 16)
+    {
+        uint64_t lo = 0, hi = 0;
+
+        if (len >= 8)
+        {
+            lo = read64_le(p);
+            hi = read64_le(p + len - 8);
+        }
+        else if (len >= 4)
+        {
+            lo = read32_le(p);
+            hi = read32_le(p + len - 4);
+        }
+        else if (len > 0)
+        {
+            lo = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+        }
+
+        h = R::enc(R::xor_(R::make(lo, hi), s), k1);
+    }
+    else if (len <= 32)
+    {
+        Block a = R::enc(R::xor_(R::load(p), s), k1);
+        Block b = R::enc(R::xor_(R::load(p + len - 16), s), k2);
+
+        h = R::enc(a, b);
+    }
+    else if (len <= 64)
+    {
+        Block a = R::enc(R::xor_(R::load(p), s), k1);
+        Block b = R::enc(R::xor_(R::load(p + 16), s), k2);
+        Block c = R::enc(R::xor_(R::load(p + len - 32), s), k3);
+        Block d = R::enc(R::xor_(R::load(p + len - 16), s), k4);
+
+        h = R::enc(R::enc(a, b), R::enc(c, d));
+    }
+    else
+    {
+        Block a = R::xor_(s, k1), b = R::xor_(s, k2), c = R::xor_(s, k3), d = R::xor_(s, k4);
+        const uint8_t *last = p + len - 64;
+
+        // four independent lanes, so the rounds of one 64-byte chunk overlap
+        for (; p < last; p += 64)
+        {
+            a = R::enc(R::xor_(a, R::load(p)), k1);
+            b = R::enc(R::xor_(b, R::load(p + 16)), k2);
+            c = R::enc(R::xor_(c, R::load(p + 32)), k3);
+            d = R::enc(R::xor_(d, R::load(p + 48)), k4);
+        }
+
+        a = R::enc(R::xor_(a, R::load(last)), k1);
+        b = R::enc(R::xor_(b, R::load(last + 16)), k2);
+        c = R::enc(R::xor_(c, R::load(last + 32)), k3);
+        d = R::enc(R::xor_(d, R::load(last + 48)), k4);
+
+        h = R::enc(R::enc(a, b), R::enc(c, d));
+    }
+
+    return R::low64(R::enc(R::enc(h, k2), k3));
+}
+
+#if defined(AESHASH_NI) && !defined(__AES__)
+
+static bool aeshash_has_aesni()
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_AES) != 0;
+}
+
+#endif
+
+uint64_t aeshash64(const void *data, size_t len, uint64_t seed)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+#if defined(AESHASH_NI) && defined(__AES__)
+    return aeshash<AesRoundNi>(p, len, seed);
+#elif defined(AESHASH_NI)
+    static const bool has_aesni = aeshash_has_aesni();
+
+    if (has_aesni)
+        return aeshash<AesRoundNi>(p, len, seed);
+
+    return aeshash<AesRoundSoft>(p, len, seed);
+#else
+    return aeshash<AesRoundSoft>(p, len, seed);
+#endif
+}
+
+uint64_t aeshash64_soft(const void *data, size_t len, uint64_t seed)
+{
+    return aeshash<AesRoundSoft>((const uint8_t *)data, len, seed);
+}
+
+// wyhash (final version 4.2) and rapidhash, by Wang Yi and Nicolas De Carli
+
+#if defined(__GNUC__)
+#define FASTHASH_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define FASTHASH_ALWAYS_INLINE inline
+#endif
+
+// The full 128-bit product of A and B, the low half in A and the high half in B
+static FASTHASH_ALWAYS_INLINE void mum128(uint64_t *A, uint64_t *B)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*A * *B;
+
+    *A = (uint64_t)r;
+    *B = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *A >> 32, hb = *B >> 32, la = (uint32_t)*A, lb = (uint32_t)*B;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+
+    c += lo < t;
+    *A = lo;
+    *B = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static FASTHASH_ALWAYS_INLINE uint64_t mum_mix(uint64_t A, uint64_t B)
+{
+    mum128(&A, &B);
+
+    return A ^ B;
+}
+
+static const uint64_t WYHASH_SECRET[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+                                          0x4d5a2da51de1aa47ull};
+
+static const uint64_t RAPIDHASH_SECRET[3] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull};
+
+// 1 to 3 bytes, the first, middle and last byte
+static FASTHASH_ALWAYS_INLINE uint64_t read_small(const uint8_t *p, size_t len, int hi, int mid)
+{
+    return ((uint64_t)p[0] << hi) | ((uint64_t)p[len >> 1] << mid) | p[len - 1];
+}
+
+// Always inlined, so that a constant `len` folds every length branch away
+static FASTHASH_ALWAYS_INLINE uint64_t wyhash_impl(const uint8_t *p, size_t len, uint64_t seed)
+{
+    const uint64_t *secret = WYHASH_SECRET;
+    uint64_t a, b;
+
+    seed ^= mum_mix(seed ^ secret[0], secret[1]);
+
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            a = (read32_le(p) << 32) | read32_le(p + ((len >> 3) << 2));
+            b = (read32_le(p + len - 4) << 32) | read32_le(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0)
+        {
+            a = read_small(p, len, 16, 8);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+
+        if (i >= 48)
+        {
+            uint64_t see1 = seed, see2 = seed;
+
+            do
+            {
+                seed = mum_mix(read64_le(p) ^ secret[1], read64_le(p + 8) ^ seed);
+                see1 = mum_mix(read64_le(p + 16) ^ secret[2], read64_le(p + 24) ^ see1);
+                see2 = mum_mix(read64_le(p + 32) ^ secret[3], read64_le(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16)
+        {
+            seed = mum_mix(read64_le(p) ^ secret[1], read64_le(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = read64_le(p + i - 16);
+        b = read64_le(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    mum128(&a, &b);
+
+    return mum_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+static FASTHASH_ALWAYS_INLINE uint64_t rapidhash_impl(const uint8_t *p, size_t len, uint64_t seed)
+{
+    const uint64_t *secret = RAPIDHASH_SECRET;
+    uint64_t a, b;
+
+    seed ^= mum_mix(seed ^ secret[0], secret[1]) ^ len;
+
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            const uint8_t *plast = p + len - 4;
+            const uint64_t delta = (len & 24) >> (len >> 3);
+
+            a = (read32_le(p) << 32) | read32_le(plast);
+            b = (read32_le(p + delta) << 32) | read32_le(plast - delta);
+        }
+        else if (len > 0)
+        {
+            a = read_small(p, len, 56, 32);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+
+        if (i > 48)
+        {
+            uint64_t see1 = seed, see2 = seed;
+
+            do
+            {
+                seed = mum_mix(read64_le(p) ^ secret[0], read64_le(p + 8) ^ seed);
+                see1 = mum_mix(read64_le(p + 16) ^ secret[1], read64_le(p + 24) ^ see1);
+                see2 = mum_mix(read64_le(p + 32) ^ secret[2], read64_le(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        if (i > 16)
+        {
+            seed = mum_mix(read64_le(p) ^ secret[2], read64_le(p + 8) ^ seed ^ secret[1]);
+
+            if (i > 32)
+                seed = mum_mix(read64_le(p + 16) ^ secret[2], read64_le(p + 24) ^ seed);
+        }
+
+        a = read64_le(p + i - 16);
+        b = read64_le(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    mum128(&a, &b);
+
+    return mum_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+template <size_t N>
+static uint64_t wyhash_fixed(const void *key, uint64_t seed)
+{
+    return wyhash_impl((const uint8_t *)key, N, seed);
+}
+
+template <size_t N>
+static uint64_t rapidhash_fixed(const void *key, uint64_t seed)
+{
+    return rapidhash_impl((const uint8_t *)key, N, seed);
+}
+
+uint64_t wyhash(const void *key, size_t len, uint64_t seed)
+{
+    return wyhash_impl((const uint8_t *)key, len, seed);
+}
+
+uint64_t wyhash_fixed4(const void *key, uint64_t seed) { return wyhash_fixed<4>(key, seed); }
+
+uint64_t wyhash_fixed8(const void *key, uint64_t seed) { return wyhash_fixed<8>(key, seed); }
+
+uint64_t wyhash_fixed16(const void *key, uint64_t seed) { return wyhash_fixed<16>(key, seed); }
+
+uint64_t wyhash_fixed32(const void *key, uint64_t seed) { return wyhash_fixed<32>(key, seed); }
+
+uint64_t rapidhash(const void *key, size_t len, uint64_t seed)
+{
+    return rapidhash_impl((const uint8_t *)key, len, seed);
+}
+
+uint64_t rapidhash_fixed4(const void *key, uint64_t seed) { return rapidhash_fixed<4>(key, seed); }
+
+uint64_t rapidhash_fixed8(const void *key, uint64_t seed) { return rapidhash_fixed<8>(key, seed); }
+
+uint64_t rapidhash_fixed16(const void *key, uint64_t seed) { return rapidhash_fixed<16>(key, seed); }
+
+uint64_t rapidhash_fixed32(const void *key, uint64_t seed) { return rapidhash_fixed<32>(key, seed); }
@@ -49,3 +49,211 @@ uint64_t t1ha0_64(const void *data, size_t length, uint64_t seed);
 void HighwayHash128(const HHKey key, const char* bytes, const uint64_t size, HHResult128& hash);
 
 void HighwayHash256(const HHKey key, const char* bytes, const uint64_t size, HHResult256& hash);
+
+// Opaque streaming HighwayHash state, large enough for every target
+struct HighwayHashCat {
+    alignas(32) uint64_t state[32];
+};
+
+void HighwayHashCatStart(const HHKey key, HighwayHashCat *state);
+
+void HighwayHashCatAppend(const char* bytes, const uint64_t size, HighwayHashCat *state);
+
+uint64_t HighwayHashCatFinish64(const HighwayHashCat *state);
+
+void HighwayHashCatFinish128(const HighwayHashCat *state, HHResult128& hash);
+
+void HighwayHashCatFinish256(const HighwayHashCat *state, HHResult256& hash);
+
+uint32_t crc32c_update(uint32_t crc, const void *data, size_t len);
+
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
+XXH64_hash_t XXH3_64bits_dispatch(const void *data, size_t len);
+
+XXH64_hash_t XXH3_64bits_withSeed_dispatch(const void *data, size_t len, XXH64_hash_t seed);
+
+XXH64_hash_t XXH3_64bits_withSecret_dispatch(const void *data, size_t len, const void *secret, size_t secretSize);
+
+XXH_errorcode XXH3_64bits_update_dispatch(XXH3_state_t *state, const void *input, size_t len);
+
+XXH128_hash_t XXH3_128bits_dispatch(const void *data, size_t len);
+
+XXH128_hash_t XXH3_128bits_withSeed_dispatch(const void *data, size_t len, XXH64_hash_t seed);
+
+XXH128_hash_t XXH3_128bits_withSecret_dispatch(const void *data, size_t len, const void *secret, size_t secretSize);
+
+XXH_errorcode XXH3_128bits_update_dispatch(XXH3_state_t *state, const void *input, size_t len);
+
+enum XXH3_kernel
+{
+    XXH3_KERNEL_SCALAR,
+    XXH3_KERNEL_SSE2,
+    XXH3_KERNEL_AVX2,
+};
+
+bool XXH3_kernel_supported(XXH3_kernel kernel);
+
+XXH64_hash_t XXH3_64bits_withSeed_kernel(XXH3_kernel kernel, const void *data, size_t len, XXH64_hash_t seed);
+
+XXH64_hash_t XXH3_64bits_withSecret_kernel(XXH3_kernel kernel, const void *data, size_t len, const void *secret, size_t secretSize);
+
+XXH_errorcode XXH3_64bits_update_kernel(XXH3_kernel kernel, XXH3_state_t *state, const void *input, size_t len);
+
+XXH128_hash_t XXH3_128bits_withSeed_kernel(XXH3_kernel kernel, const void *data, size_t len, XXH64_hash_t seed);
+
+XXH128_hash_t XXH3_128bits_withSecret_kernel(XXH3_kernel kernel, const void *data, size_t len, const void *secret, size_t secretSize);
+
+XXH_errorcode XXH3_128bits_update_kernel(XXH3_kernel kernel, XXH3_state_t *state, const void *input, size_t len);
+
+uint64_t aeshash64(const void *data, size_t len, uint64_t seed);
+
+uint64_t aeshash64_soft(const void *data, size_t len, uint64_t seed);
+
+uint64_t wyhash(const void *key, size_t len, uint64_t seed);
+
+uint64_t wyhash_fixed4(const void *key, uint64_t seed);
+
+uint64_t wyhash_fixed8(const void *key, uint64_t seed);
+
+uint64_t wyhash_fixed16(const void *key, uint64_t seed);
+
+uint64_t wyhash_fixed32(const void *key, uint64_t seed);
+
+uint64_t rapidhash(const void *key, size_t len, uint64_t seed);
+
+uint64_t rapidhash_fixed4(const void *key, uint64_t seed);
+
+uint64_t rapidhash_fixed8(const void *key, uint64_t seed);
+
+uint64_t rapidhash_fixed16(const void *key, uint64_t seed);
+
+uint64_t rapidhash_fixed32(const void *key, uint64_t seed);
+
+uint64_t XXH64_fixed4(const void *data, uint64_t seed);
+
+uint64_t XXH64_fixed8(const void *data, uint64_t seed);
+
+uint64_t XXH64_fixed12(const void *data, uint64_t seed);
+
+uint64_t XXH64_fixed16(const void *data, uint64_t seed);
+
+uint64_t XXH64_fixed20(const void *data, uint64_t seed);
+
+uint64_t XXH64_fixed24(const void *data, uint64_t seed);
+
+uint64_t XXH64_fixed32(const void *data, uint64_t seed);
+
+uint64_t XXH64_fixed64(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed4(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed8(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed12(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed16(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed20(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed24(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed32(const void *data, uint64_t seed);
+
+uint64_t XXH3_64bits_fixed64(const void *data, uint64_t seed);
+
+uint64_t CityHash64_fixed4(const void *data);
+
+uint64_t CityHash64_fixed8(const void *data);
+
+uint64_t CityHash64_fixed12(const void *data);
+
+uint64_t CityHash64_fixed16(const void *data);
+
+uint64_t CityHash64_fixed20(const void *data);
+
+uint64_t CityHash64_fixed24(const void *data);
+
+uint64_t CityHash64_fixed32(const void *data);
+
+uint64_t CityHash64_fixed64(const void *data);
+
+uint64_t CityHash64WithSeed_fixed4(const void *data, uint64_t seed);
+
+uint64_t CityHash64WithSeed_fixed8(const void *data, uint64_t seed);
+
+uint64_t CityHash64WithSeed_fixed12(const void *data, uint64_t seed);
+
+uint64_t CityHash64WithSeed_fixed16(const void *data, uint64_t seed);
+
+uint64_t CityHash64WithSeed_fixed20(const void *data, uint64_t seed);
+
+uint64_t CityHash64WithSeed_fixed24(const void *data, uint64_t seed);
+
+uint64_t CityHash64WithSeed_fixed32(const void *data, uint64_t seed);
+
+uint64_t CityHash64WithSeed_fixed64(const void *data, uint64_t seed);
+
+uint64_t farmhash64_fixed4(const void *data);
+
+uint64_t farmhash64_fixed8(const void *data);
+
+uint64_t farmhash64_fixed12(const void *data);
+
+uint64_t farmhash64_fixed16(const void *data);
+
+uint64_t farmhash64_fixed20(const void *data);
+
+uint64_t farmhash64_fixed24(const void *data);
+
+uint64_t farmhash64_fixed32(const void *data);
+
+uint64_t farmhash64_fixed64(const void *data);
+
+uint64_t farmhash64_with_seed_fixed4(const void *data, uint64_t seed);
+
+uint64_t farmhash64_with_seed_fixed8(const void *data, uint64_t seed);
+
+uint64_t farmhash64_with_seed_fixed12(const void *data, uint64_t seed);
+
+uint64_t farmhash64_with_seed_fixed16(const void *data, uint64_t seed);
+
+uint64_t farmhash64_with_seed_fixed20(const void *data, uint64_t seed);
+
+uint64_t farmhash64_with_seed_fixed24(const void *data, uint64_t seed);
+
+uint64_t farmhash64_with_seed_fixed32(const void *data, uint64_t seed);
+
+uint64_t farmhash64_with_seed_fixed64(const void *data, uint64_t seed);
+
+uint64_t metrohash64_1_fixed4(const void *data, uint32_t seed);
+
+uint64_t metrohash64_1_fixed8(const void *data, uint32_t seed);
+
+uint64_t metrohash64_1_fixed12(const void *data, uint32_t seed);
+
+uint64_t metrohash64_1_fixed16(const void *data, uint32_t seed);
+
+uint64_t metrohash64_1_fixed20(const void *data, uint32_t seed);
+
+uint64_t metrohash64_1_fixed24(const void *data, uint32_t seed);
+
+uint64_t metrohash64_1_fixed32(const void *data, uint32_t seed);
+
+uint64_t metrohash64_1_fixed64(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed4(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed8(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed12(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed16(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed20(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed24(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed32(const void *data, uint32_t seed);
+
+uint32_t MurmurHash3_x86_32_fixed64(const void *data, uint32_t seed);
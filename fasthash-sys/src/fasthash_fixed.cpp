@@ -0,0 +1,175 @@
+// Fixed-length entry points, compiled once per key length.
+//
+// The sources of each family are included here, so their bodies are visible and
+// a constant length folds every length dispatch and tail loop away. This file
+// does not include fasthash.hpp, which already includes them as libraries.
+//
+// xxHash is included with XXH_INLINE_ALL. The smhasher sources are included in
+// an anonymous namespace, one namespace per family, so that their helpers and
+// the copies of their functions stay private to this file. The system headers
+// they use are included first, so they are not declared in the namespace again.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if defined(__APPLE__)
+#include <libkern/OSByteOrder.h>
+#elif defined(__linux__)
+#include <byteswap.h>
+#endif
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+#define XXH_INLINE_ALL
+#include "xxHash/xxhash.h"
+
+// farmhash-c declares its API with C linkage, which an anonymous namespace
+// does not make private, so the copies here are renamed
+#define farmhash fasthash_fixed_farmhash
+#define farmhash32 fasthash_fixed_farmhash32
+#define farmhash32_with_seed fasthash_fixed_farmhash32_with_seed
+#define farmhash64 fasthash_fixed_farmhash64
+#define farmhash64_with_seed fasthash_fixed_farmhash64_with_seed
+#define farmhash64_with_seeds fasthash_fixed_farmhash64_with_seeds
+#define farmhash128 fasthash_fixed_farmhash128
+#define farmhash128_with_seed fasthash_fixed_farmhash128_with_seed
+#define farmhash_fingerprint32 fasthash_fixed_farmhash_fingerprint32
+#define farmhash_fingerprint64 fasthash_fixed_farmhash_fingerprint64
+#define farmhash_fingerprint128 fasthash_fixed_farmhash_fingerprint128
+
+// only a few functions of each family are used
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+namespace
+{
+namespace city
+{
+#include "smhasher/City.cpp"
+} // namespace city
+
+#undef LIKELY
+#undef PERMUTE3
+#undef uint32_in_expected_order
+#undef uint64_in_expected_order
+
+namespace farm
+{
+#include "smhasher/farmhash-c.c"
+} // namespace farm
+
+namespace metro
+{
+#include "smhasher/metrohash64.cpp"
+} // namespace metro
+
+namespace murmur3
+{
+#include "smhasher/MurmurHash3.cpp"
+} // namespace murmur3
+} // namespace
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// Inline the whole call tree even where the inliner would give up on a long body
+#if defined(__GNUC__)
+#define FASTHASH_FLATTEN __attribute__((flatten))
+#else
+#define FASTHASH_FLATTEN
+#endif
+
+template <size_t N>
+static uint64_t xxh64_fixed(const void *data, uint64_t seed)
+{
+    return XXH64(data, N, seed);
+}
+
+template <size_t N>
+static uint64_t xxh3_64bits_fixed(const void *data, uint64_t seed)
+{
+    return XXH3_64bits_withSeed(data, N, seed);
+}
+
+template <size_t N>
+static uint64_t city64_fixed(const void *data)
+{
+    return city::CityHash64(static_cast<const char *>(data), N);
+}
+
+template <size_t N>
+static uint64_t city64_with_seed_fixed(const void *data, uint64_t seed)
+{
+    return city::CityHash64WithSeed(static_cast<const char *>(data), N, seed);
+}
+
+template <size_t N>
+static uint64_t farm64_fixed(const void *data)
+{
+    return farm::farmhash64(static_cast<const char *>(data), N);
+}
+
+template <size_t N>
+static uint64_t farm64_with_seed_fixed(const void *data, uint64_t seed)
+{
+    return farm::farmhash64_with_seed(static_cast<const char *>(data), N, seed);
+}
+
+template <size_t N>
+static uint64_t metro64_1_fixed(const void *data, uint32_t seed)
+{
+    uint64_t hash;
+
+    metro::metrohash64_1(static_cast<const uint8_t *>(data), N, seed, reinterpret_cast<uint8_t *>(&hash));
+
+    return hash;
+}
+
+template <size_t N>
+static uint32_t murmur3_x86_32_fixed(const void *data, uint32_t seed)
+{
+    uint32_t hash;
+
+    murmur3::MurmurHash3_x86_32(data, N, seed, &hash);
+
+    return hash;
+}
+
+#define FASTHASH_FIXED(result, name, impl, n, params, args) \
+    FASTHASH_FLATTEN result name##n params                  \
+    {                                                       \
+        return impl<n> args;                                \
+    }
+
+#define FASTHASH_FIXED_LENGTHS(result, name, impl, params, args) \
+    FASTHASH_FIXED(result, name, impl, 4, params, args)          \
+    FASTHASH_FIXED(result, name, impl, 8, params, args)          \
+    FASTHASH_FIXED(result, name, impl, 12, params, args)         \
+    FASTHASH_FIXED(result, name, impl, 16, params, args)         \
+    FASTHASH_FIXED(result, name, impl, 20, params, args)         \
+    FASTHASH_FIXED(result, name, impl, 24, params, args)         \
+    FASTHASH_FIXED(result, name, impl, 32, params, args)         \
+    FASTHASH_FIXED(result, name, impl, 64, params, args)
+
+FASTHASH_FIXED_LENGTHS(uint64_t, XXH64_fixed, xxh64_fixed, (const void *data, uint64_t seed), (data, seed))
+FASTHASH_FIXED_LENGTHS(uint64_t, XXH3_64bits_fixed, xxh3_64bits_fixed, (const void *data, uint64_t seed), (data, seed))
+FASTHASH_FIXED_LENGTHS(uint64_t, CityHash64_fixed, city64_fixed, (const void *data), (data))
+FASTHASH_FIXED_LENGTHS(uint64_t, CityHash64WithSeed_fixed, city64_with_seed_fixed, (const void *data, uint64_t seed), (data, seed))
+FASTHASH_FIXED_LENGTHS(uint64_t, farmhash64_fixed, farm64_fixed, (const void *data), (data))
+FASTHASH_FIXED_LENGTHS(uint64_t, farmhash64_with_seed_fixed, farm64_with_seed_fixed, (const void *data, uint64_t seed), (data, seed))
+FASTHASH_FIXED_LENGTHS(uint64_t, metrohash64_1_fixed, metro64_1_fixed, (const void *data, uint32_t seed), (data, seed))
+FASTHASH_FIXED_LENGTHS(uint32_t, MurmurHash3_x86_32_fixed, murmur3_x86_32_fixed, (const void *data, uint32_t seed), (data, seed))
@@ -1354,6 +1354,493 @@ extern "C" {
         hash: *mut HHResult256,
     );
 }
+extern "C" {
+    #[link_name = "\u{1}_Z13crc32c_updatejPKvm"]
+    pub fn crc32c_update(crc: u32, data: *const ::std::os::raw::c_void, len: usize) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z14crc32c_combinejjm"]
+    pub fn crc32c_combine(crc1: u32, crc2: u32, len2: u64) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z20XXH3_64bits_dispatchPKvm"]
+    pub fn XXH3_64bits_dispatch(data: *const ::std::os::raw::c_void, len: usize) -> XXH64_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z29XXH3_64bits_withSeed_dispatchPKvmm"]
+    pub fn XXH3_64bits_withSeed_dispatch(
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        seed: XXH64_hash_t,
+    ) -> XXH64_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z31XXH3_64bits_withSecret_dispatchPKvmS0_m"]
+    pub fn XXH3_64bits_withSecret_dispatch(
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        secret: *const ::std::os::raw::c_void,
+        secretSize: usize,
+    ) -> XXH64_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z27XXH3_64bits_update_dispatchP12XXH3_state_sPKvm"]
+    pub fn XXH3_64bits_update_dispatch(
+        state: *mut XXH3_state_t,
+        input: *const ::std::os::raw::c_void,
+        len: usize,
+    ) -> XXH_errorcode;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z21XXH3_128bits_dispatchPKvm"]
+    pub fn XXH3_128bits_dispatch(data: *const ::std::os::raw::c_void, len: usize) -> XXH128_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z30XXH3_128bits_withSeed_dispatchPKvmm"]
+    pub fn XXH3_128bits_withSeed_dispatch(
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        seed: XXH64_hash_t,
+    ) -> XXH128_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z32XXH3_128bits_withSecret_dispatchPKvmS0_m"]
+    pub fn XXH3_128bits_withSecret_dispatch(
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        secret: *const ::std::os::raw::c_void,
+        secretSize: usize,
+    ) -> XXH128_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28XXH3_128bits_update_dispatchP12XXH3_state_sPKvm"]
+    pub fn XXH3_128bits_update_dispatch(
+        state: *mut XXH3_state_t,
+        input: *const ::std::os::raw::c_void,
+        len: usize,
+    ) -> XXH_errorcode;
+}
+pub const XXH3_kernel_XXH3_KERNEL_SCALAR: XXH3_kernel = 0;
+pub const XXH3_kernel_XXH3_KERNEL_SSE2: XXH3_kernel = 1;
+pub const XXH3_kernel_XXH3_KERNEL_AVX2: XXH3_kernel = 2;
+pub type XXH3_kernel = u32;
+extern "C" {
+    #[link_name = "\u{1}_Z21XXH3_kernel_supported11XXH3_kernel"]
+    pub fn XXH3_kernel_supported(kernel: XXH3_kernel) -> bool;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z27XXH3_64bits_withSeed_kernel11XXH3_kernelPKvmm"]
+    pub fn XXH3_64bits_withSeed_kernel(
+        kernel: XXH3_kernel,
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        seed: XXH64_hash_t,
+    ) -> XXH64_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z29XXH3_64bits_withSecret_kernel11XXH3_kernelPKvmS1_m"]
+    pub fn XXH3_64bits_withSecret_kernel(
+        kernel: XXH3_kernel,
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        secret: *const ::std::os::raw::c_void,
+        secretSize: usize,
+    ) -> XXH64_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z25XXH3_64bits_update_kernel11XXH3_kernelP12XXH3_state_sPKvm"]
+    pub fn XXH3_64bits_update_kernel(
+        kernel: XXH3_kernel,
+        state: *mut XXH3_state_t,
+        input: *const ::std::os::raw::c_void,
+        len: usize,
+    ) -> XXH_errorcode;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28XXH3_128bits_withSeed_kernel11XXH3_kernelPKvmm"]
+    pub fn XXH3_128bits_withSeed_kernel(
+        kernel: XXH3_kernel,
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        seed: XXH64_hash_t,
+    ) -> XXH128_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z30XXH3_128bits_withSecret_kernel11XXH3_kernelPKvmS1_m"]
+    pub fn XXH3_128bits_withSecret_kernel(
+        kernel: XXH3_kernel,
+        data: *const ::std::os::raw::c_void,
+        len: usize,
+        secret: *const ::std::os::raw::c_void,
+        secretSize: usize,
+    ) -> XXH128_hash_t;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26XXH3_128bits_update_kernel11XXH3_kernelP12XXH3_state_sPKvm"]
+    pub fn XXH3_128bits_update_kernel(
+        kernel: XXH3_kernel,
+        state: *mut XXH3_state_t,
+        input: *const ::std::os::raw::c_void,
+        len: usize,
+    ) -> XXH_errorcode;
+}
+#[repr(C)]
+#[repr(align(32))]
+#[derive(Copy, Clone)]
+pub struct HighwayHashCat {
+    pub state: [u64; 32usize],
+}
+#[test]
+fn bindgen_test_layout_HighwayHashCat() {
+    assert_eq!(
+        ::std::mem::size_of::<HighwayHashCat>(),
+        256usize,
+        concat!("Size of: ", stringify!(HighwayHashCat))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<HighwayHashCat>(),
+        32usize,
+        concat!("Alignment of ", stringify!(HighwayHashCat))
+    );
+    assert_eq!(
+        unsafe { &(*(::std::ptr::null::<HighwayHashCat>())).state as *const _ as usize },
+        0usize,
+        concat!(
+            "Offset of field: ",
+            stringify!(HighwayHashCat),
+            "::",
+            stringify!(state)
+        )
+    );
+}
+extern "C" {
+    #[link_name = "\u{1}_Z19HighwayHashCatStartPKmP14HighwayHashCat"]
+    pub fn HighwayHashCatStart(key: *const u64, state: *mut HighwayHashCat);
+}
+extern "C" {
+    #[link_name = "\u{1}_Z20HighwayHashCatAppendPKcmP14HighwayHashCat"]
+    pub fn HighwayHashCatAppend(
+        bytes: *const ::std::os::raw::c_char,
+        size: u64,
+        state: *mut HighwayHashCat,
+    );
+}
+extern "C" {
+    #[link_name = "\u{1}_Z22HighwayHashCatFinish64PK14HighwayHashCat"]
+    pub fn HighwayHashCatFinish64(state: *const HighwayHashCat) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z23HighwayHashCatFinish128PK14HighwayHashCatRA2_m"]
+    pub fn HighwayHashCatFinish128(state: *const HighwayHashCat, hash: *mut HHResult128);
+}
+extern "C" {
+    #[link_name = "\u{1}_Z23HighwayHashCatFinish256PK14HighwayHashCatRA4_m"]
+    pub fn HighwayHashCatFinish256(state: *const HighwayHashCat, hash: *mut HHResult256);
+}
+extern "C" {
+    #[link_name = "\u{1}_Z9aeshash64PKvmm"]
+    pub fn aeshash64(data: *const ::std::os::raw::c_void, len: usize, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z14aeshash64_softPKvmm"]
+    pub fn aeshash64_soft(data: *const ::std::os::raw::c_void, len: usize, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z6wyhashPKvmm"]
+    pub fn wyhash(key: *const ::std::os::raw::c_void, len: usize, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13wyhash_fixed4PKvm"]
+    pub fn wyhash_fixed4(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13wyhash_fixed8PKvm"]
+    pub fn wyhash_fixed8(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z14wyhash_fixed16PKvm"]
+    pub fn wyhash_fixed16(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z14wyhash_fixed32PKvm"]
+    pub fn wyhash_fixed32(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z9rapidhashPKvmm"]
+    pub fn rapidhash(key: *const ::std::os::raw::c_void, len: usize, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z16rapidhash_fixed4PKvm"]
+    pub fn rapidhash_fixed4(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z16rapidhash_fixed8PKvm"]
+    pub fn rapidhash_fixed8(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z17rapidhash_fixed16PKvm"]
+    pub fn rapidhash_fixed16(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z17rapidhash_fixed32PKvm"]
+    pub fn rapidhash_fixed32(key: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z12XXH64_fixed4PKvm"]
+    pub fn XXH64_fixed4(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z12XXH64_fixed8PKvm"]
+    pub fn XXH64_fixed8(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13XXH64_fixed12PKvm"]
+    pub fn XXH64_fixed12(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13XXH64_fixed16PKvm"]
+    pub fn XXH64_fixed16(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13XXH64_fixed20PKvm"]
+    pub fn XXH64_fixed20(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13XXH64_fixed24PKvm"]
+    pub fn XXH64_fixed24(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13XXH64_fixed32PKvm"]
+    pub fn XXH64_fixed32(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z13XXH64_fixed64PKvm"]
+    pub fn XXH64_fixed64(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18XXH3_64bits_fixed4PKvm"]
+    pub fn XXH3_64bits_fixed4(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18XXH3_64bits_fixed8PKvm"]
+    pub fn XXH3_64bits_fixed8(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z19XXH3_64bits_fixed12PKvm"]
+    pub fn XXH3_64bits_fixed12(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z19XXH3_64bits_fixed16PKvm"]
+    pub fn XXH3_64bits_fixed16(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z19XXH3_64bits_fixed20PKvm"]
+    pub fn XXH3_64bits_fixed20(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z19XXH3_64bits_fixed24PKvm"]
+    pub fn XXH3_64bits_fixed24(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z19XXH3_64bits_fixed32PKvm"]
+    pub fn XXH3_64bits_fixed32(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z19XXH3_64bits_fixed64PKvm"]
+    pub fn XXH3_64bits_fixed64(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z17CityHash64_fixed4PKv"]
+    pub fn CityHash64_fixed4(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z17CityHash64_fixed8PKv"]
+    pub fn CityHash64_fixed8(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18CityHash64_fixed12PKv"]
+    pub fn CityHash64_fixed12(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18CityHash64_fixed16PKv"]
+    pub fn CityHash64_fixed16(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18CityHash64_fixed20PKv"]
+    pub fn CityHash64_fixed20(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18CityHash64_fixed24PKv"]
+    pub fn CityHash64_fixed24(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18CityHash64_fixed32PKv"]
+    pub fn CityHash64_fixed32(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18CityHash64_fixed64PKv"]
+    pub fn CityHash64_fixed64(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z25CityHash64WithSeed_fixed4PKvm"]
+    pub fn CityHash64WithSeed_fixed4(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z25CityHash64WithSeed_fixed8PKvm"]
+    pub fn CityHash64WithSeed_fixed8(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26CityHash64WithSeed_fixed12PKvm"]
+    pub fn CityHash64WithSeed_fixed12(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26CityHash64WithSeed_fixed16PKvm"]
+    pub fn CityHash64WithSeed_fixed16(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26CityHash64WithSeed_fixed20PKvm"]
+    pub fn CityHash64WithSeed_fixed20(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26CityHash64WithSeed_fixed24PKvm"]
+    pub fn CityHash64WithSeed_fixed24(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26CityHash64WithSeed_fixed32PKvm"]
+    pub fn CityHash64WithSeed_fixed32(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26CityHash64WithSeed_fixed64PKvm"]
+    pub fn CityHash64WithSeed_fixed64(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z17farmhash64_fixed4PKv"]
+    pub fn farmhash64_fixed4(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z17farmhash64_fixed8PKv"]
+    pub fn farmhash64_fixed8(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18farmhash64_fixed12PKv"]
+    pub fn farmhash64_fixed12(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18farmhash64_fixed16PKv"]
+    pub fn farmhash64_fixed16(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18farmhash64_fixed20PKv"]
+    pub fn farmhash64_fixed20(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18farmhash64_fixed24PKv"]
+    pub fn farmhash64_fixed24(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18farmhash64_fixed32PKv"]
+    pub fn farmhash64_fixed32(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z18farmhash64_fixed64PKv"]
+    pub fn farmhash64_fixed64(data: *const ::std::os::raw::c_void) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z27farmhash64_with_seed_fixed4PKvm"]
+    pub fn farmhash64_with_seed_fixed4(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z27farmhash64_with_seed_fixed8PKvm"]
+    pub fn farmhash64_with_seed_fixed8(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28farmhash64_with_seed_fixed12PKvm"]
+    pub fn farmhash64_with_seed_fixed12(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28farmhash64_with_seed_fixed16PKvm"]
+    pub fn farmhash64_with_seed_fixed16(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28farmhash64_with_seed_fixed20PKvm"]
+    pub fn farmhash64_with_seed_fixed20(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28farmhash64_with_seed_fixed24PKvm"]
+    pub fn farmhash64_with_seed_fixed24(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28farmhash64_with_seed_fixed32PKvm"]
+    pub fn farmhash64_with_seed_fixed32(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z28farmhash64_with_seed_fixed64PKvm"]
+    pub fn farmhash64_with_seed_fixed64(data: *const ::std::os::raw::c_void, seed: u64) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z20metrohash64_1_fixed4PKvj"]
+    pub fn metrohash64_1_fixed4(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z20metrohash64_1_fixed8PKvj"]
+    pub fn metrohash64_1_fixed8(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z21metrohash64_1_fixed12PKvj"]
+    pub fn metrohash64_1_fixed12(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z21metrohash64_1_fixed16PKvj"]
+    pub fn metrohash64_1_fixed16(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z21metrohash64_1_fixed20PKvj"]
+    pub fn metrohash64_1_fixed20(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z21metrohash64_1_fixed24PKvj"]
+    pub fn metrohash64_1_fixed24(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z21metrohash64_1_fixed32PKvj"]
+    pub fn metrohash64_1_fixed32(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z21metrohash64_1_fixed64PKvj"]
+    pub fn metrohash64_1_fixed64(data: *const ::std::os::raw::c_void, seed: u32) -> u64;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z25MurmurHash3_x86_32_fixed4PKvj"]
+    pub fn MurmurHash3_x86_32_fixed4(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z25MurmurHash3_x86_32_fixed8PKvj"]
+    pub fn MurmurHash3_x86_32_fixed8(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26MurmurHash3_x86_32_fixed12PKvj"]
+    pub fn MurmurHash3_x86_32_fixed12(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26MurmurHash3_x86_32_fixed16PKvj"]
+    pub fn MurmurHash3_x86_32_fixed16(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26MurmurHash3_x86_32_fixed20PKvj"]
+    pub fn MurmurHash3_x86_32_fixed20(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26MurmurHash3_x86_32_fixed24PKvj"]
+    pub fn MurmurHash3_x86_32_fixed24(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26MurmurHash3_x86_32_fixed32PKvj"]
+    pub fn MurmurHash3_x86_32_fixed32(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
+extern "C" {
+    #[link_name = "\u{1}_Z26MurmurHash3_x86_32_fixed64PKvj"]
+    pub fn MurmurHash3_x86_32_fixed64(data: *const ::std::os::raw::c_void, seed: u32) -> u32;
+}
 #[test]
 fn __bindgen_test_layout_pair_open0_uint64_uint64_close0_instantiation() {
     assert_eq!(
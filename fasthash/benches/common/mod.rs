@@ -0,0 +1,130 @@
+//! Shared by the benchmarks that run over every hash family.
+#![allow(dead_code, unused_macros)]
+
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::thread;
+
+pub mod stats;
+
+#[cfg(all(
+    target_os = "linux",
+    any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")
+))]
+pub mod perf;
+
+/// The hardware event that the criterion benchmarks count instead of the wall time.
+pub const EVENT_VAR: &str = "FASTHASH_BENCH_EVENT";
+
+/// The number of threads of the benchmarks that run on several threads.
+pub const THREADS_VAR: &str = "FASTHASH_BENCH_THREADS";
+
+/// Returns the filter on family names given on the command line, if any.
+pub fn filter() -> Option<String> {
+    // `cargo bench` passes `--bench` to every target
+    std::env::args().skip(1).find(|arg| !arg.starts_with("--"))
+}
+
+/// Returns the number of threads set with `FASTHASH_BENCH_THREADS`,
+/// or else the available parallelism.
+pub fn threads() -> usize {
+    std::env::var(THREADS_VAR)
+        .ok()
+        .and_then(|n| n.parse().ok())
+        .unwrap_or_else(|| thread::available_parallelism().map_or(1, |n| n.get()))
+        .max(1)
+}
+
+/// Calls `f` with every job, on up to `threads` threads that each take the next job left.
+pub fn run_jobs<J, F>(jobs: &[J], threads: usize, f: F)
+where
+    J: Sync,
+    F: Fn(&J) + Sync,
+{
+    let next = AtomicUsize::new(0);
+    let (next, f) = (&next, &f);
+
+    thread::scope(|s| {
+        for _ in 0..threads.min(jobs.len()) {
+            s.spawn(move || {
+                while let Some(job) = jobs.get(next.fetch_add(1, Ordering::Relaxed)) {
+                    f(job);
+                }
+            });
+        }
+    });
+}
+
+/// Calls `$bench::<H>(name, $arg)` for every `FastHash` family `H`, named by its path.
+macro_rules! for_each_family {
+    ($bench:ident, $arg:expr) => {
+        for_each_family! { @ $bench, $arg;
+            aeshash::Hash64,
+            city::Hash32,
+            city::Hash64,
+            city::Hash128,
+            #[cfg(any(feature = "sse42", target_feature = "sse4.2"))]
+            city::crc::Hash128,
+            crc32c::Hash32,
+            farm::Hash32,
+            farm::Hash64,
+            farm::Hash128,
+            highway::Hash64,
+            highway::Hash128,
+            lookup3::Hash32,
+            metro::Hash64_1,
+            metro::Hash64_2,
+            metro::Hash128_1,
+            metro::Hash128_2,
+            #[cfg(any(feature = "sse42", target_feature = "sse4.2"))]
+            metro::crc::Hash64_1,
+            #[cfg(any(feature = "sse42", target_feature = "sse4.2"))]
+            metro::crc::Hash64_2,
+            #[cfg(any(feature = "sse42", target_feature = "sse4.2"))]
+            metro::crc::Hash128_1,
+            #[cfg(any(feature = "sse42", target_feature = "sse4.2"))]
+            metro::crc::Hash128_2,
+            mum::Hash64,
+            murmur::Hash32,
+            murmur::Hash32Aligned,
+            murmur2::Hash32,
+            murmur2::Hash32A,
+            murmur2::Hash32Neutral,
+            murmur2::Hash32Aligned,
+            murmur2::Hash64_x64,
+            murmur2::Hash64_x86,
+            murmur3::Hash32,
+            murmur3::Hash128_x64,
+            murmur3::Hash128_x86,
+            rapid::Hash64,
+            sea::Hash64,
+            spooky::Hash32,
+            spooky::Hash64,
+            spooky::Hash128,
+            #[cfg(feature = "t1ha")]
+            t1ha0::Hash64,
+            #[cfg(feature = "t1ha")]
+            t1ha1::Hash64Le,
+            #[cfg(feature = "t1ha")]
+            t1ha1::Hash64Be,
+            #[cfg(feature = "t1ha")]
+            t1ha2::Hash64AtOnce,
+            #[cfg(feature = "t1ha")]
+            t1ha2::Hash128AtOnce,
+            wy::Hash64,
+            xx::Hash32,
+            xx::Hash64,
+            xxh3::Hash64,
+            xxh3::Hash128,
+        }
+    };
+    // the path is rebuilt with `concat!`, since `stringify!` would space out its `::`
+    (@ $bench:ident, $arg:expr; $($(#[$attr:meta])* $module:ident $(:: $name:ident)+,)*) => {
+        $(
+            $(#[$attr])*
+            $bench::<$module $(:: $name)+>(
+                concat!(stringify!($module) $(, "::", stringify!($name))+),
+                $arg,
+            );
+        )*
+    };
+}
@@ -0,0 +1,409 @@
+//! Hardware performance counters of the calling thread, read with Linux `perf_event_open`.
+//!
+//! The counters are opened as one group, so that they are scheduled onto the PMU
+//! together and their ratios, such as instructions per cycle, are consistent.
+//! Only user space is counted, which `perf_event_paranoid` allows up to level 2.
+use std::env;
+use std::fmt;
+use std::fs::File;
+use std::io::{self, Read};
+use std::os::raw::{c_int, c_long, c_ulong};
+use std::os::unix::io::{AsRawFd, FromRawFd};
+
+use criterion::measurement::{Measurement, ValueFormatter};
+use criterion::Throughput;
+
+#[cfg(target_arch = "x86_64")]
+const SYS_PERF_EVENT_OPEN: c_long = 298;
+#[cfg(target_arch = "x86")]
+const SYS_PERF_EVENT_OPEN: c_long = 336;
+#[cfg(target_arch = "aarch64")]
+const SYS_PERF_EVENT_OPEN: c_long = 241;
+
+const PERF_TYPE_HARDWARE: u32 = 0;
+const PERF_TYPE_HW_CACHE: u32 = 3;
+
+const PERF_COUNT_HW_CPU_CYCLES: u64 = 0;
+const PERF_COUNT_HW_INSTRUCTIONS: u64 = 1;
+const PERF_COUNT_HW_BRANCH_MISSES: u64 = 5;
+
+// cache id | operation << 8 | result << 16
+const PERF_COUNT_HW_CACHE_L1D_READ_MISS: u64 = 0 | 0 << 8 | 1 << 16;
+const PERF_COUNT_HW_CACHE_LL_READ_MISS: u64 = 2 | 0 << 8 | 1 << 16;
+
+const PERF_FORMAT_TOTAL_TIME_ENABLED: u64 = 1 << 0;
+const PERF_FORMAT_TOTAL_TIME_RUNNING: u64 = 1 << 1;
+const PERF_FORMAT_GROUP: u64 = 1 << 3;
+
+const ATTR_DISABLED: u64 = 1 << 0;
+const ATTR_EXCLUDE_KERNEL: u64 = 1 << 5;
+const ATTR_EXCLUDE_HV: u64 = 1 << 6;
+
+const PERF_EVENT_IOC_ENABLE: c_ulong = 0x2400;
+const PERF_EVENT_IOC_RESET: c_ulong = 0x2403;
+const PERF_IOC_FLAG_GROUP: c_ulong = 1;
+
+extern "C" {
+    fn syscall(num: c_long, ...) -> c_long;
+    fn ioctl(fd: c_int, request: c_ulong, ...) -> c_int;
+}
+
+/// `struct perf_event_attr`, up to `PERF_ATTR_SIZE_VER5`.
+#[repr(C)]
+#[derive(Default)]
+struct PerfEventAttr {
+    kind: u32,
+    size: u32,
+    config: u64,
+    sample_period: u64,
+    sample_type: u64,
+    read_format: u64,
+    flags: u64,
+    wakeup_events: u32,
+    bp_type: u32,
+    config1: u64,
+    config2: u64,
+    branch_sample_type: u64,
+    sample_regs_user: u64,
+    sample_stack_user: u32,
+    clockid: i32,
+    sample_regs_intr: u64,
+    aux_watermark: u32,
+    sample_max_stack: u16,
+    reserved: u16,
+}
+
+/// A hardware event counted by `Counters`.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Event {
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1dMisses,
+    LlcMisses,
+}
+
+impl Event {
+    pub const ALL: [Event; 5] = [
+        Event::Cycles,
+        Event::Instructions,
+        Event::BranchMisses,
+        Event::L1dMisses,
+        Event::LlcMisses,
+    ];
+
+    /// Parses the name of an event, as `perf list` spells it.
+    pub fn from_name(name: &str) -> Option<Event> {
+        Event::ALL
+            .iter()
+            .cloned()
+            .find(|event| event.name() == name)
+    }
+
+    pub fn name(self) -> &'static str {
+        match self {
+            Event::Cycles => "cycles",
+            Event::Instructions => "instructions",
+            Event::BranchMisses => "branch-misses",
+            Event::L1dMisses => "L1-dcache-load-misses",
+            Event::LlcMisses => "LLC-load-misses",
+        }
+    }
+
+    fn per_byte(self) -> &'static str {
+        match self {
+            Event::Cycles => "cycles/B",
+            Event::Instructions => "instructions/B",
+            Event::BranchMisses => "branch-misses/B",
+            Event::L1dMisses => "L1-dcache-load-misses/B",
+            Event::LlcMisses => "LLC-load-misses/B",
+        }
+    }
+
+    fn per_element(self) -> &'static str {
+        match self {
+            Event::Cycles => "cycles/elem",
+            Event::Instructions => "instructions/elem",
+            Event::BranchMisses => "branch-misses/elem",
+            Event::L1dMisses => "L1-dcache-load-misses/elem",
+            Event::LlcMisses => "LLC-load-misses/elem",
+        }
+    }
+
+    fn kind_and_config(self) -> (u32, u64) {
+        match self {
+            Event::Cycles => (PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+            Event::Instructions => (PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+            Event::BranchMisses => (PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES),
+            Event::L1dMisses => (PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D_READ_MISS),
+            Event::LlcMisses => (PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL_READ_MISS),
+        }
+    }
+}
+
+impl fmt::Display for Event {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.write_str(self.name())
+    }
+}
+
+fn open(event: Event, group: Option<&File>) -> io::Result<File> {
+    let (kind, config) = event.kind_and_config();
+    let attr = PerfEventAttr {
+        kind,
+        size: std::mem::size_of::<PerfEventAttr>() as u32,
+        config,
+        read_format: PERF_FORMAT_GROUP
+            | PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING,
+        // members of a group follow the leader, which starts disabled
+        flags: ATTR_EXCLUDE_KERNEL
+            | ATTR_EXCLUDE_HV
+            | if group.is_none() { ATTR_DISABLED } else { 0 },
+        ..Default::default()
+    };
+    let group_fd = group.map_or(-1, |f| f.as_raw_fd());
+
+    // this thread, on any CPU
+    let fd = unsafe {
+        syscall(
+            SYS_PERF_EVENT_OPEN,
+            &attr as *const PerfEventAttr,
+            0 as c_int,
+            -1 as c_int,
+            group_fd as c_int,
+            0 as c_ulong,
+        )
+    };
+
+    if fd < 0 {
+        Err(io::Error::last_os_error())
+    } else {
+        Ok(unsafe { File::from_raw_fd(fd as c_int) })
+    }
+}
+
+/// A group of the hardware counters in `Event::ALL` that the CPU supports.
+pub struct Counters {
+    leader: File,
+    events: Vec<Event>,
+    _members: Vec<File>,
+}
+
+/// The counts of the events of `Counters`, at one point in time.
+#[derive(Clone, Debug, Default)]
+pub struct Counts {
+    events: Vec<Event>,
+    values: Vec<u64>,
+}
+
+impl Counts {
+    /// Returns the count of `event`, if the CPU supports it.
+    pub fn get(&self, event: Event) -> Option<u64> {
+        self.events
+            .iter()
+            .position(|&e| e == event)
+            .map(|i| self.values[i])
+    }
+
+    /// Returns the counts since `earlier`.
+    ///
+    /// Counts scaled up for multiplexing are estimates, and may go backwards,
+    /// so a difference that would be negative is zero.
+    pub fn since(&self, earlier: &Counts) -> Counts {
+        Counts {
+            events: self.events.clone(),
+            values: self
+                .values
+                .iter()
+                .zip(&earlier.values)
+                .map(|(now, then)| now.saturating_sub(*then))
+                .collect(),
+        }
+    }
+}
+
+impl Counters {
+    /// Opens and starts the counters for the calling thread.
+    ///
+    /// Fails if the CPU cycles can not be counted, for example in a virtual machine
+    /// without a virtual PMU, or with `perf_event_paranoid` above 2.
+    pub fn new() -> io::Result<Self> {
+        let leader = open(Event::Cycles, None)?;
+        let mut events = vec![Event::Cycles];
+        let mut members = vec![];
+
+        for &event in &Event::ALL[1..] {
+            if let Ok(f) = open(event, Some(&leader)) {
+                events.push(event);
+                members.push(f);
+            }
+        }
+
+        unsafe {
+            ioctl(
+                leader.as_raw_fd(),
+                PERF_EVENT_IOC_RESET,
+                PERF_IOC_FLAG_GROUP,
+            );
+            if ioctl(
+                leader.as_raw_fd(),
+                PERF_EVENT_IOC_ENABLE,
+                PERF_IOC_FLAG_GROUP,
+            ) < 0
+            {
+                return Err(io::Error::last_os_error());
+            }
+        }
+
+        Ok(Counters {
+            leader,
+            events,
+            _members: members,
+        })
+    }
+
+    /// Returns the events being counted.
+    pub fn events(&self) -> &[Event] {
+        &self.events
+    }
+
+    /// Reads the current counts, scaled up if the group was multiplexed with others.
+    pub fn read(&self) -> Counts {
+        let mut buf = vec![0_u8; 8 * (3 + self.events.len())];
+
+        (&self.leader)
+            .read_exact(&mut buf)
+            .expect("read perf counters");
+
+        let words = buf
+            .chunks(8)
+            .map(|b| {
+                let mut w = [0; 8];
+                w.copy_from_slice(b);
+                u64::from_ne_bytes(w)
+            })
+            .collect::<Vec<_>>();
+        let (enabled, running) = (words[1], words[2]);
+
+        Counts {
+            events: self.events.clone(),
+            values: words[3..]
+                .iter()
+                .map(|&v| {
+                    if running == 0 || running == enabled {
+                        v
+                    } else {
+                        (v as f64 * enabled as f64 / running as f64) as u64
+                    }
+                })
+                .collect(),
+        }
+    }
+}
+
+/// A criterion `Measurement` of one hardware event, instead of the wall time.
+///
+/// The counters count the thread that criterion runs the benchmarks on,
+/// which is the thread that constructs the measurement.
+pub struct Perf {
+    event: Event,
+    counters: Counters,
+}
+
+impl Perf {
+    pub fn new(event: Event) -> io::Result<Self> {
+        let counters = Counters::new()?;
+
+        if !counters.events().contains(&event) {
+            return Err(io::Error::new(
+                io::ErrorKind::NotFound,
+                format!("{} is not supported by this CPU", event),
+            ));
+        }
+
+        Ok(Perf { event, counters })
+    }
+
+    /// Counts the event named by `FASTHASH_BENCH_EVENT`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the event is unknown or can not be counted.
+    pub fn from_env() -> Self {
+        let name = env::var(super::EVENT_VAR).unwrap_or_default();
+        let event = Event::from_name(&name).unwrap_or_else(|| {
+            panic!(
+                "{}={} is not one of {:?}",
+                super::EVENT_VAR,
+                name,
+                Event::ALL.iter().map(|e| e.name()).collect::<Vec<_>>()
+            )
+        });
+
+        Perf::new(event).unwrap_or_else(|err| panic!("can not count {}: {}", event, err))
+    }
+
+    fn count(&self) -> u64 {
+        self.counters.read().get(self.event).unwrap_or_default()
+    }
+}
+
+impl Measurement for Perf {
+    type Intermediate = u64;
+    type Value = u64;
+
+    fn start(&self) -> u64 {
+        self.count()
+    }
+
+    fn end(&self, start: u64) -> u64 {
+        // a multiplexed count is scaled, and may read lower than before
+        self.count().saturating_sub(start)
+    }
+
+    fn add(&self, v1: &u64, v2: &u64) -> u64 {
+        v1 + v2
+    }
+
+    fn zero(&self) -> u64 {
+        0
+    }
+
+    fn to_f64(&self, value: &u64) -> f64 {
+        *value as f64
+    }
+
+    fn formatter(&self) -> &dyn ValueFormatter {
+        self
+    }
+}
+
+impl ValueFormatter for Perf {
+    fn scale_values(&self, _typical: f64, _values: &mut [f64]) -> &'static str {
+        self.event.name()
+    }
+
+    fn scale_throughputs(
+        &self,
+        _typical: f64,
+        throughput: &Throughput,
+        values: &mut [f64],
+    ) -> &'static str {
+        // the count per byte or element, rather than per unit of time
+        let (n, unit) = match *throughput {
+            Throughput::Bytes(n) => (n, self.event.per_byte()),
+            Throughput::Elements(n) => (n, self.event.per_element()),
+        };
+
+        for v in values {
+            *v /= n as f64;
+        }
+
+        unit
+    }
+
+    fn scale_for_machines(&self, _values: &mut [f64]) -> &'static str {
+        self.event.name()
+    }
+}
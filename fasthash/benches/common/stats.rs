@@ -0,0 +1,69 @@
+//! Statistics of hash values, compared with those of a random function.
+
+/// Sorts `values` and counts those equal to the one before.
+pub fn collisions<T: Ord>(values: &mut [T]) -> usize {
+    values.sort_unstable();
+    values.windows(2).filter(|w| w[0] == w[1]).count()
+}
+
+/// The expected number of collisions among `n` random values of `bits` bits,
+/// counted as `collisions` does, `n - m (1 - e^(-n/m))` with `m = 2^bits`.
+pub fn expected_collisions(n: usize, bits: u32) -> f64 {
+    let n = n as f64;
+    let m = 2_f64.powi(bits as i32);
+    let x = n / m;
+
+    if x < 1e-3 {
+        // `m (x - 1 + e^(-x))` by its series, since the terms cancel out
+        m * x * x * (0.5 - x / 6.0 + x * x / 24.0)
+    } else {
+        n + m * (-x).exp_m1()
+    }
+}
+
+/// The probability that a Poisson variable with mean `lambda` is at least `k`.
+pub fn poisson_tail(k: usize, lambda: f64) -> f64 {
+    if k == 0 {
+        return 1.0;
+    }
+    if lambda <= 0.0 {
+        return 0.0;
+    }
+
+    // sum the terms from `k` up, starting in the log domain
+    let ln_factorial = (2..=k).map(|i| (i as f64).ln()).sum::<f64>();
+    let mut term = (k as f64 * lambda.ln() - lambda - ln_factorial).exp();
+    let mut sum = 0.0;
+    let mut i = k;
+
+    loop {
+        sum += term;
+        i += 1;
+        term *= lambda / i as f64;
+
+        if term <= sum * 1e-12 {
+            break;
+        }
+    }
+
+    sum.min(1.0)
+}
+
+/// The chi-square statistic of `counts`, against the uniform distribution of their sum.
+pub fn chi_square(counts: &[u32]) -> f64 {
+    let expected = counts.iter().map(|&n| f64::from(n)).sum::<f64>() / counts.len() as f64;
+
+    counts
+        .iter()
+        .map(|&n| (f64::from(n) - expected).powi(2) / expected)
+        .sum()
+}
+
+/// How many standard deviations `chi_square` is above its mean for `buckets` buckets.
+///
+/// The chi-square distribution is close to normal for many buckets.
+pub fn chi_square_z(chi_square: f64, buckets: usize) -> f64 {
+    let df = (buckets - 1) as f64;
+
+    (chi_square - df) / (2.0 * df).sqrt()
+}
@@ -0,0 +1,341 @@
+//! Collisions, bucket distribution and throughput of every hash family on a corpus of real keys.
+//!
+//! Synthetic keys tell little about how a family behaves on the keys of one
+//! application, such as URLs that share long prefixes, or records that differ in
+//! a few bits. The corpus is mapped into memory and read as one key per line or,
+//! with `FASTHASH_BENCH_RECORD`, as binary records of that many bytes, and
+//! duplicate keys are dropped. Each family hashes every key once, on a thread of
+//! its own, and this reports
+//!
+//! * `GB/s`, the hash throughput over the keys, measured while the other families
+//!   run on the other threads, see `FASTHASH_BENCH_THREADS`
+//! * `coll64` and `coll32`, the collisions in the low 64 and 32 bits of the hashes,
+//!   and how many a random function would have
+//! * `pow2` and `prime`, the chi-square of the keys in as many buckets as a table
+//!   with a power of two or a prime number of buckets at a load factor of one,
+//!   indexed by the low bits or by the remainder, as standard deviations above
+//!   the mean of a random function
+//!
+//! Families with unlikely collision counts or a chi-square more than 5 standard
+//! deviations above the mean are marked as unsafe, and the safe ones are listed
+//! from the fastest.
+//!
+//! ```bash
+//! $ FASTHASH_BENCH_CORPUS=urls.txt cargo bench --bench corpus
+//! $ FASTHASH_BENCH_CORPUS=ids.bin FASTHASH_BENCH_RECORD=16 cargo bench --bench corpus -- xx
+//! ```
+#[macro_use]
+mod common;
+
+use std::collections::HashSet;
+use std::env;
+use std::io::{self, Write};
+use std::mem;
+use std::sync::Mutex;
+use std::time::Instant;
+
+use num_traits::ToPrimitive;
+
+use fasthash::*;
+
+use common::stats;
+
+// collision counts less likely than this for a random function are unsafe
+const P_LIMIT: f64 = 1e-6;
+const Z_LIMIT: f64 = 5.0;
+
+#[cfg(unix)]
+mod map {
+    use std::fs::File;
+    use std::io;
+    use std::ops::Deref;
+    use std::os::raw::{c_int, c_long, c_void};
+    use std::os::unix::io::AsRawFd;
+    use std::path::Path;
+    use std::ptr;
+    use std::slice;
+
+    const PROT_READ: c_int = 1;
+    const MAP_PRIVATE: c_int = 2;
+
+    extern "C" {
+        fn mmap(
+            addr: *mut c_void,
+            len: usize,
+            prot: c_int,
+            flags: c_int,
+            fd: c_int,
+            offset: c_long,
+        ) -> *mut c_void;
+        fn munmap(addr: *mut c_void, len: usize) -> c_int;
+    }
+
+    /// A read only mapping of a whole file.
+    pub struct Mmap {
+        ptr: *mut c_void,
+        len: usize,
+    }
+
+    // the mapping is never written
+    unsafe impl Sync for Mmap {}
+
+    impl Mmap {
+        pub fn open<P: AsRef<Path>>(path: P) -> io::Result<Self> {
+            let file = File::open(path)?;
+            let len = file.metadata()?.len() as usize;
+
+            if len == 0 {
+                return Ok(Mmap {
+                    ptr: ptr::null_mut(),
+                    len,
+                });
+            }
+
+            let ptr = unsafe {
+                mmap(
+                    ptr::null_mut(),
+                    len,
+                    PROT_READ,
+                    MAP_PRIVATE,
+                    file.as_raw_fd(),
+                    0,
+                )
+            };
+
+            if ptr as isize == -1 {
+                Err(io::Error::last_os_error())
+            } else {
+                Ok(Mmap { ptr, len })
+            }
+        }
+    }
+
+    impl Deref for Mmap {
+        type Target = [u8];
+
+        fn deref(&self) -> &[u8] {
+            if self.len == 0 {
+                &[]
+            } else {
+                unsafe { slice::from_raw_parts(self.ptr as *const u8, self.len) }
+            }
+        }
+    }
+
+    impl Drop for Mmap {
+        fn drop(&mut self) {
+            if self.len > 0 {
+                unsafe {
+                    munmap(self.ptr, self.len);
+                }
+            }
+        }
+    }
+}
+
+#[cfg(not(unix))]
+mod map {
+    use std::fs;
+    use std::io;
+    use std::ops::Deref;
+    use std::path::Path;
+
+    pub struct Mmap(Vec<u8>);
+
+    impl Mmap {
+        pub fn open<P: AsRef<Path>>(path: P) -> io::Result<Self> {
+            fs::read(path).map(Mmap)
+        }
+    }
+
+    impl Deref for Mmap {
+        type Target = [u8];
+
+        fn deref(&self) -> &[u8] {
+            &self.0
+        }
+    }
+}
+
+/// Splits the corpus into distinct keys, of one line or of one `record` each.
+fn split_keys(data: &[u8], record: Option<usize>) -> (Vec<&[u8]>, usize) {
+    let mut keys = match record {
+        Some(size) => data.chunks_exact(size).collect::<Vec<_>>(),
+        None => data
+            .split(|&b| b == b'\n')
+            .map(|line| line.strip_suffix(b"\r").unwrap_or(line))
+            .filter(|line| !line.is_empty())
+            .collect(),
+    };
+    let total = keys.len();
+    let mut seen = HashSet::with_capacity(total);
+
+    keys.retain(|key| seen.insert(*key));
+
+    (keys, total)
+}
+
+fn is_prime(n: usize) -> bool {
+    n >= 2 && (2..).take_while(|i| i * i <= n).all(|i| n % i != 0)
+}
+
+struct Analysis {
+    name: &'static str,
+    gbps: f64,
+    // found and expected collisions
+    coll64: Option<(usize, f64)>,
+    coll32: (usize, f64),
+    // chi-square z scores
+    pow2: f64,
+    prime: f64,
+}
+
+impl Analysis {
+    fn safe(&self) -> bool {
+        self.coll64
+            .iter()
+            .chain(Some(&self.coll32))
+            .all(|&(found, expected)| stats::poisson_tail(found, expected) >= P_LIMIT)
+            && self.pow2 <= Z_LIMIT
+            && self.prime <= Z_LIMIT
+    }
+}
+
+fn collisions(hashes: &[u64], mask: u64, bits: u32) -> (usize, f64) {
+    let mut values = hashes.iter().map(|h| h & mask).collect::<Vec<_>>();
+
+    (
+        stats::collisions(&mut values),
+        stats::expected_collisions(values.len(), bits),
+    )
+}
+
+fn buckets<F: Fn(u64) -> usize>(hashes: &[u64], buckets: usize, index: F) -> f64 {
+    let mut counts = vec![0_u32; buckets];
+
+    for &h in hashes {
+        counts[index(h)] += 1;
+    }
+
+    stats::chi_square_z(stats::chi_square(&counts), buckets)
+}
+
+fn analyze<H: FastHash>(name: &'static str, keys: &[&[u8]]) -> Analysis {
+    let bits = mem::size_of::<H::Hash>() * 8;
+    let bytes = keys.iter().map(|key| key.len()).sum::<usize>();
+
+    let start = Instant::now();
+    // the low 64 bits of wider hashes
+    let hashes = keys
+        .iter()
+        .map(|key| H::hash(key).to_u128().unwrap() as u64)
+        .collect::<Vec<_>>();
+    let elapsed = start.elapsed();
+
+    let pow2 = keys.len().next_power_of_two().max(2);
+    let prime = (keys.len().max(2)..).find(|&n| is_prime(n)).unwrap();
+
+    Analysis {
+        name,
+        gbps: bytes as f64 / elapsed.as_secs_f64() / 1e9,
+        coll64: if bits > 32 {
+            Some(collisions(&hashes, !0, 64))
+        } else {
+            None
+        },
+        coll32: collisions(&hashes, 0xFFFF_FFFF, 32),
+        pow2: buckets(&hashes, pow2, |h| h as usize & (pow2 - 1)),
+        prime: buckets(&hashes, prime, |h| (h % prime as u64) as usize),
+    }
+}
+
+type Job = (&'static str, fn(&'static str, &[&[u8]]) -> Analysis);
+
+fn job<H: FastHash>(name: &'static str, (filter, jobs): (Option<&str>, &mut Vec<Job>)) {
+    if filter.map_or(true, |filter| name.contains(filter)) {
+        jobs.push((name, analyze::<H>));
+    }
+}
+
+fn print_collisions(coll: Option<(usize, f64)>) -> String {
+    coll.map_or_else(
+        || "-".to_owned(),
+        |(found, expected)| format!("{} ({:.1})", found, expected),
+    )
+}
+
+fn main() {
+    let path = match env::var("FASTHASH_BENCH_CORPUS") {
+        Ok(path) => path,
+        Err(_) => {
+            eprintln!("set FASTHASH_BENCH_CORPUS to a file of keys to analyze");
+            return;
+        }
+    };
+    let record = env::var("FASTHASH_BENCH_RECORD")
+        .ok()
+        .map(|n| n.parse().expect("FASTHASH_BENCH_RECORD"));
+    let threads = common::threads();
+
+    let data = map::Mmap::open(&path).unwrap_or_else(|err| panic!("open {}: {}", path, err));
+    let (keys, total) = split_keys(&data, record);
+
+    println!(
+        "{}: {} keys, {} distinct, {} bytes",
+        path,
+        total,
+        keys.len(),
+        keys.iter().map(|key| key.len()).sum::<usize>()
+    );
+
+    if keys.is_empty() {
+        return;
+    }
+
+    let filter = common::filter();
+    let mut jobs = vec![];
+
+    for_each_family!(job, (filter.as_ref().map(|s| s.as_str()), &mut jobs));
+
+    println!(
+        "{:<28} {:>8} {:>16} {:>16} {:>8} {:>8}",
+        "family", "GB/s", "coll64", "coll32", "pow2", "prime"
+    );
+
+    let results = Mutex::new(vec![]);
+
+    common::run_jobs(&jobs, threads, |&(name, analyze)| {
+        let a = analyze(name, &keys);
+        let stdout = io::stdout();
+
+        let _ = writeln!(
+            stdout.lock(),
+            "{:<28} {:>8.3} {:>16} {:>16} {:>8.1} {:>8.1}{}",
+            a.name,
+            a.gbps,
+            print_collisions(a.coll64),
+            print_collisions(Some(a.coll32)),
+            a.pow2,
+            a.prime,
+            if a.safe() { "" } else { "  unsafe" }
+        );
+
+        results.lock().unwrap().push(a);
+    });
+
+    let mut safe = results
+        .into_inner()
+        .unwrap()
+        .into_iter()
+        .filter(Analysis::safe)
+        .collect::<Vec<_>>();
+
+    safe.sort_by(|a, b| b.gbps.partial_cmp(&a.gbps).unwrap());
+
+    println!();
+    println!("safe on this corpus, from the fastest:");
+
+    for a in safe {
+        println!("  {:<28} {:>8.3} GB/s", a.name, a.gbps);
+    }
+}
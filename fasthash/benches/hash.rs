@@ -4,23 +4,48 @@
 extern crate lazy_static;
 #[macro_use]
 extern crate criterion;
+#[macro_use]
+mod common;
 
+use std::env;
 use std::mem;
 use std::slice;
 
-use criterion::{black_box, Criterion, ParameterizedBenchmark, Throughput};
+use criterion::measurement::Measurement;
+use criterion::{
+    black_box, BenchmarkGroup, BenchmarkId, Criterion, ParameterizedBenchmark, Throughput,
+};
 
 use fasthash::*;
 
 const KB: usize = 1024;
 const SEED: u64 = 0x0123456789ABCDEF;
 const PARAMS: [usize; 7] = [7, 8, 32, 256, KB, 4 * KB, 16 * KB];
+const SMALL_PARAMS: [usize; 4] = [7, 8, 32, 256];
+
+// keys are hashed at every byte offset from an aligned address up to this one
+const ALIGN: usize = 16;
+const UNALIGNED_SIZE: usize = 256;
+
+// the cold buffer must be larger than the last level cache
+const COLD_BITS: u32 = 28;
+const COLD_SIZE: usize = 1 << COLD_BITS;
 
 lazy_static! {
     static ref DATA: Vec<u8> = (0..16 * KB).map(|b| b as u8).collect::<Vec<_>>();
+    // written rather than zeroed, so that every page is backed by its own memory
+    static ref COLD: Vec<u8> = (0..COLD_SIZE + 16 * KB)
+        .map(|b| b as u8)
+        .collect::<Vec<_>>();
 }
 
-fn bench_memory(c: &mut Criterion) {
+/// Returns the `i`-th of a pseudo-random sequence of indexes below `1 << bits`.
+#[inline(always)]
+fn scatter(i: u64, bits: u32) -> usize {
+    (i.wrapping_mul(0x9E37_79B9_7F4A_7C15) >> (64 - bits)) as usize
+}
+
+fn bench_memory<M: Measurement + 'static>(c: &mut Criterion<M>) {
     c.bench(
         "memory",
         ParameterizedBenchmark::new(
@@ -40,7 +65,7 @@ fn bench_memory(c: &mut Criterion) {
     );
 }
 
-fn bench_hash32(c: &mut Criterion) {
+fn bench_hash32<M: Measurement + 'static>(c: &mut Criterion<M>) {
     c.bench(
         "hash32",
         ParameterizedBenchmark::new(
@@ -50,6 +75,9 @@ fn bench_hash32(c: &mut Criterion) {
             },
             &PARAMS,
         )
+        .with_function("crc32c::hash32", move |b, &&size| {
+            b.iter(|| crc32c::hash32_with_seed(&DATA[..size], SEED as u32));
+        })
         .with_function("farm::hash32", move |b, &&size| {
             b.iter(|| farm::hash32_with_seed(&DATA[..size], SEED as u32));
         })
@@ -90,7 +118,7 @@ fn bench_hash32(c: &mut Criterion) {
     );
 }
 
-fn bench_hash64(c: &mut Criterion) {
+fn bench_hash64<M: Measurement + 'static>(c: &mut Criterion<M>) {
     let mut bench = ParameterizedBenchmark::new(
         "city::hash64",
         move |b, &&size| {
@@ -98,6 +126,9 @@ fn bench_hash64(c: &mut Criterion) {
         },
         &PARAMS,
     )
+    .with_function("aeshash::hash64", move |b, &&size| {
+        b.iter(|| aeshash::hash64_with_seed(&DATA[..size], SEED));
+    })
     .with_function("farm::hash64", move |b, &&size| {
         b.iter(|| farm::hash64_with_seed(&DATA[..size], SEED));
     })
@@ -119,12 +150,18 @@ fn bench_hash64(c: &mut Criterion) {
     .with_function("murmur2::hash64_x86", move |b, &&size| {
         b.iter(|| murmur2::Hash64_x86::hash_with_seed(&DATA[..size], SEED));
     })
+    .with_function("rapid::hash64", move |b, &&size| {
+        b.iter(|| rapid::hash64_with_seed(&DATA[..size], SEED));
+    })
     .with_function("sea::hash64", move |b, &&size| {
         b.iter(|| sea::hash64_with_seeds(&DATA[..size], SEED, SEED, SEED, SEED));
     })
     .with_function("spooky::hash64", move |b, &&size| {
         b.iter(|| spooky::hash64_with_seed(&DATA[..size], SEED));
     })
+    .with_function("wy::hash64", move |b, &&size| {
+        b.iter(|| wy::hash64_with_seed(&DATA[..size], SEED));
+    })
     .with_function("xx::hash64", move |b, &&size| {
         b.iter(|| xx::hash64_with_seed(&DATA[..size], SEED));
     })
@@ -163,7 +200,7 @@ fn bench_hash64(c: &mut Criterion) {
     );
 }
 
-fn bench_hash128(c: &mut Criterion) {
+fn bench_hash128<M: Measurement + 'static>(c: &mut Criterion<M>) {
     let mut bench = ParameterizedBenchmark::new(
         "city::hash128",
         move |b, &&size| {
@@ -225,11 +262,156 @@ fn bench_hash128(c: &mut Criterion) {
     );
 }
 
+fn unaligned<H: FastHash>(group: &mut BenchmarkGroup<impl Measurement>, name: &str) {
+    for offset in 0..ALIGN {
+        group.bench_with_input(BenchmarkId::new(name, offset), &offset, |b, &offset| {
+            b.iter(|| H::hash(&DATA[offset..offset + UNALIGNED_SIZE]));
+        });
+    }
+}
+
+fn cold<H: FastHash>(group: &mut BenchmarkGroup<impl Measurement>, size: usize, name: &str) {
+    group.bench_with_input(BenchmarkId::new(name, size), &size, |b, &size| {
+        let mut i = 0;
+
+        b.iter(|| {
+            i += 1;
+
+            let off = scatter(i, COLD_BITS);
+
+            H::hash(&COLD[off..off + size])
+        });
+    });
+}
+
+fn scattered<H: FastHash>(
+    group: &mut BenchmarkGroup<impl Measurement>,
+    keys: &[Box<[u8]>],
+    bits: u32,
+    name: &str,
+) {
+    let size = keys[0].len();
+
+    group.bench_with_input(BenchmarkId::new(name, size), keys, |b, keys| {
+        let mut i = 0;
+
+        b.iter(|| {
+            i += 1;
+
+            H::hash(&keys[scatter(i, bits)])
+        });
+    });
+}
+
+macro_rules! hash64_families {
+    ($bench:ident($($arg:expr),*)) => {
+        $bench::<aeshash::Hash64>($($arg,)* "aeshash::hash64");
+        $bench::<city::Hash64>($($arg,)* "city::hash64");
+        $bench::<farm::Hash64>($($arg,)* "farm::hash64");
+        $bench::<highway::Hash64>($($arg,)* "highway::hash64");
+        $bench::<metro::Hash64_1>($($arg,)* "metro::hash64_1");
+        $bench::<mum::Hash64>($($arg,)* "mum::hash64");
+        $bench::<murmur2::Hash64_x64>($($arg,)* "murmur2::hash64_x64");
+        $bench::<rapid::Hash64>($($arg,)* "rapid::hash64");
+        $bench::<sea::Hash64>($($arg,)* "sea::hash64");
+        $bench::<spooky::Hash64>($($arg,)* "spooky::hash64");
+        #[cfg(feature = "t1ha")]
+        $bench::<t1ha2::Hash64AtOnce>($($arg,)* "t1ha2::hash64_atonce");
+        $bench::<wy::Hash64>($($arg,)* "wy::hash64");
+        $bench::<xx::Hash64>($($arg,)* "xx::hash64");
+        $bench::<xxh3::Hash64>($($arg,)* "xxh3::hash64");
+    };
+}
+
+/// Hashes a key at every byte offset from an aligned address.
+fn bench_unaligned<M: Measurement + 'static>(c: &mut Criterion<M>) {
+    let mut group = c.benchmark_group("unaligned");
+
+    group.throughput(Throughput::Bytes(UNALIGNED_SIZE as u64));
+
+    hash64_families!(unaligned(&mut group));
+
+    group.finish();
+}
+
+/// Hashes keys at random offsets in a buffer larger than the last level cache.
+fn bench_cold<M: Measurement + 'static>(c: &mut Criterion<M>) {
+    let mut group = c.benchmark_group("cold");
+
+    for &size in &PARAMS {
+        group.throughput(Throughput::Bytes(size as u64));
+
+        hash64_families!(cold(&mut group, size));
+    }
+
+    group.finish();
+}
+
+/// Hashes keys in random order from as many separate allocations
+/// as fill the cold buffer.
+fn bench_scattered<M: Measurement + 'static>(c: &mut Criterion<M>) {
+    let mut group = c.benchmark_group("scattered");
+
+    for &size in &SMALL_PARAMS {
+        // a power of two, counting the allocator's overhead for each key
+        let count = (COLD_SIZE / (size + 32)).next_power_of_two() / 2;
+        let bits = count.trailing_zeros();
+        let keys = (0..count)
+            .map(|i| DATA[i % KB..][..size].to_vec().into_boxed_slice())
+            .collect::<Vec<_>>();
+
+        group.throughput(Throughput::Bytes(size as u64));
+
+        hash64_families!(scattered(&mut group, &keys, bits));
+    }
+
+    group.finish();
+}
+
 criterion_group!(
     benches,
     bench_memory,
     bench_hash32,
     bench_hash64,
     bench_hash128,
+    bench_unaligned,
+    bench_cold,
+    bench_scattered,
 );
-criterion_main!(benches);
+
+// counts a hardware event instead of the wall time, see `common/perf.rs`
+#[cfg(all(
+    target_os = "linux",
+    any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")
+))]
+criterion_group! {
+    name = perf_benches;
+    config = Criterion::default().with_measurement(common::perf::Perf::from_env());
+    targets =
+        bench_memory,
+        bench_hash32,
+        bench_hash64,
+        bench_hash128,
+        bench_unaligned,
+        bench_cold,
+        bench_scattered
+}
+
+fn main() {
+    if env::var_os(common::EVENT_VAR).is_none() {
+        benches();
+    } else {
+        #[cfg(all(
+            target_os = "linux",
+            any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")
+        ))]
+        perf_benches();
+        #[cfg(not(all(
+            target_os = "linux",
+            any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")
+        )))]
+        panic!("{} requires Linux perf_event_open", common::EVENT_VAR);
+    }
+
+    Criterion::default().configure_from_args().final_summary();
+}
@@ -0,0 +1,128 @@
+//! The cost of the streaming `Hasher`s apart from the hash function itself.
+//!
+//! * `construct` creates and drops a hasher with `new`, `with_seed` and
+//!   `with_random_seed`, and hashes a single `u64` through it, as a `HashMap` does;
+//!   `xx`, `spooky` and `t1ha2` allocate their state on the heap
+//! * `chunked` hashes the same 4 KiB in writes of 1 byte up to a single write,
+//!   and with `StreamHasher::write_stream` from a `Cursor`
+//!
+//! ```bash
+//! $ cargo bench --bench hasher -- chunked/xx::Hasher64
+//! ```
+#[macro_use]
+extern crate criterion;
+
+use std::io::Cursor;
+
+use criterion::measurement::WallTime;
+use criterion::{black_box, BenchmarkGroup, BenchmarkId, Criterion, Throughput};
+
+use fasthash::*;
+
+const KB: usize = 1024;
+const TOTAL: usize = 4 * KB;
+const CHUNKS: [usize; 6] = [1, 8, 64, 256, KB, TOTAL];
+
+fn construct<H: FastHasher>(group: &mut BenchmarkGroup<WallTime>, name: &str) {
+    group.bench_function(BenchmarkId::new("new", name), |b| b.iter(H::new));
+
+    group.bench_function(BenchmarkId::new("with_seed", name), |b| {
+        b.iter(|| H::with_seed(black_box(Default::default())))
+    });
+
+    group.bench_function(BenchmarkId::new("with_random_seed", name), |b| {
+        b.iter(H::with_random_seed)
+    });
+
+    group.bench_function(BenchmarkId::new("hash_u64", name), |b| {
+        let mut n = 0_u64;
+
+        b.iter(|| {
+            let mut h = H::new();
+
+            n += 1;
+            h.write_u64(n);
+            h.finish()
+        })
+    });
+}
+
+fn chunked<H: FastHasher>(group: &mut BenchmarkGroup<WallTime>, name: &str) {
+    let data = (0..TOTAL).map(|b| b as u8).collect::<Vec<_>>();
+
+    for &chunk in &CHUNKS {
+        group.bench_with_input(BenchmarkId::new(name, chunk), &chunk, |b, &chunk| {
+            b.iter(|| {
+                let mut h = H::new();
+
+                for buf in data.chunks(chunk) {
+                    h.write(buf);
+                }
+
+                h.finish()
+            })
+        });
+    }
+}
+
+fn stream<H: StreamHasher>(group: &mut BenchmarkGroup<WallTime>, name: &str) {
+    let data = (0..TOTAL).map(|b| b as u8).collect::<Vec<_>>();
+
+    group.bench_function(BenchmarkId::new(name, "write_stream"), |b| {
+        b.iter(|| {
+            let mut h = H::new();
+
+            h.write_stream(&mut Cursor::new(&data)).unwrap();
+            h.finish()
+        })
+    });
+}
+
+fn bench_construct(c: &mut Criterion) {
+    let mut group = c.benchmark_group("construct");
+
+    construct::<city::Hasher64>(&mut group, "city::Hasher64");
+    construct::<crc32c::Hasher32>(&mut group, "crc32c::Hasher32");
+    construct::<highway::Hasher64>(&mut group, "highway::Hasher64");
+    construct::<sea::Hasher64>(&mut group, "sea::Hasher64");
+    construct::<spooky::Hasher128>(&mut group, "spooky::Hasher128");
+    #[cfg(feature = "t1ha")]
+    construct::<t1ha2::Hasher128>(&mut group, "t1ha2::Hasher128");
+    construct::<wy::Hasher64>(&mut group, "wy::Hasher64");
+    construct::<xx::Hasher32>(&mut group, "xx::Hasher32");
+    construct::<xx::Hasher64>(&mut group, "xx::Hasher64");
+    construct::<xxh3::Hasher64>(&mut group, "xxh3::Hasher64");
+    construct::<xxh3::Hasher128>(&mut group, "xxh3::Hasher128");
+
+    group.finish();
+}
+
+fn bench_chunked(c: &mut Criterion) {
+    let mut group = c.benchmark_group("chunked");
+
+    group.throughput(Throughput::Bytes(TOTAL as u64));
+
+    chunked::<city::Hasher64>(&mut group, "city::Hasher64");
+    chunked::<crc32c::Hasher32>(&mut group, "crc32c::Hasher32");
+    stream::<crc32c::Hasher32>(&mut group, "crc32c::Hasher32");
+    chunked::<highway::Hasher64>(&mut group, "highway::Hasher64");
+    stream::<highway::Hasher64>(&mut group, "highway::Hasher64");
+    chunked::<sea::Hasher64>(&mut group, "sea::Hasher64");
+    stream::<sea::Hasher64>(&mut group, "sea::Hasher64");
+    chunked::<spooky::Hasher128>(&mut group, "spooky::Hasher128");
+    stream::<spooky::Hasher128>(&mut group, "spooky::Hasher128");
+    #[cfg(feature = "t1ha")]
+    chunked::<t1ha2::Hasher128>(&mut group, "t1ha2::Hasher128");
+    #[cfg(feature = "t1ha")]
+    stream::<t1ha2::Hasher128>(&mut group, "t1ha2::Hasher128");
+    chunked::<wy::Hasher64>(&mut group, "wy::Hasher64");
+    chunked::<xx::Hasher64>(&mut group, "xx::Hasher64");
+    stream::<xx::Hasher64>(&mut group, "xx::Hasher64");
+    chunked::<xxh3::Hasher64>(&mut group, "xxh3::Hasher64");
+    stream::<xxh3::Hasher64>(&mut group, "xxh3::Hasher64");
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_construct, bench_chunked);
+criterion_main!(benches);
@@ -0,0 +1,157 @@
+//! Builds and probes a `std::collections::HashMap` with every hasher in the crate.
+//!
+//! The benchmarks in `hash.rs` call the hash functions directly, which hides the
+//! cost of the `Hasher` interface that a `HashMap` goes through: the buffered
+//! hashers built by `trivial_hasher!` copy every key into a `Vec` before hashing
+//! it, and every key type adds its own `write_*` calls, such as the length prefix
+//! of a `str`. A `HashSet` is a `HashMap` with `()` values, and behaves the same.
+//!
+//! For every family, with its fixed state and with a `RandomState`, and for `u64`
+//! keys, short strings, UUIDs and long URLs, this measures the rate of
+//!
+//! * `insert`, building a map from empty
+//! * `lookup`, finding every key of the map
+//! * `miss`, looking up as many keys that are not in it
+//!
+//! The standard library's SipHash `RandomState` is included as a baseline.
+//!
+//! ```bash
+//! $ cargo bench --bench hashmap -- hashmap/url/lookup
+//! ```
+#[macro_use]
+extern crate criterion;
+#[macro_use]
+mod common;
+
+use std::collections::hash_map;
+use std::collections::HashMap;
+use std::hash::{BuildHasher, Hash};
+use std::time::Duration;
+
+use criterion::measurement::WallTime;
+use criterion::{BenchmarkGroup, BenchmarkId, Criterion, Throughput};
+
+use fasthash::*;
+
+const KEYS: usize = 16 * 1024;
+
+struct Workload<K> {
+    keys: Vec<K>,
+    misses: Vec<K>,
+}
+
+impl<K: Hash + Eq> Workload<K> {
+    /// Generates the keys from `0..KEYS` and the misses from the numbers after them.
+    fn new<F: Fn(u64) -> K>(f: F) -> Self {
+        Workload {
+            keys: (0..KEYS as u64).map(&f).collect(),
+            misses: (KEYS as u64..2 * KEYS as u64).map(&f).collect(),
+        }
+    }
+
+    fn bench<S, F>(&self, group: &mut BenchmarkGroup<WallTime>, name: &str, state: F)
+    where
+        S: BuildHasher,
+        F: Fn() -> S,
+    {
+        let keys = &self.keys;
+        let misses = &self.misses;
+
+        group.bench_function(BenchmarkId::new("insert", name), |b| {
+            b.iter(|| {
+                let mut map = HashMap::with_hasher(state());
+
+                for (i, key) in keys.iter().enumerate() {
+                    map.insert(key, i);
+                }
+
+                map
+            })
+        });
+
+        let mut map = HashMap::with_hasher(state());
+
+        map.extend(keys.iter().zip(0_usize..));
+
+        group.bench_function(BenchmarkId::new("lookup", name), |b| {
+            b.iter(|| keys.iter().filter_map(|key| map.get(key)).sum::<usize>())
+        });
+
+        group.bench_function(BenchmarkId::new("miss", name), |b| {
+            b.iter(|| misses.iter().filter(|key| map.contains_key(key)).count())
+        });
+    }
+}
+
+fn hasher<H: FastHash + Default>(
+    name: &str,
+    (group, workload): (&mut BenchmarkGroup<WallTime>, &Workload<impl Hash + Eq>),
+) {
+    workload.bench(group, name, H::default);
+    workload.bench(
+        group,
+        &format!("RandomState<{}>", name),
+        RandomState::<H>::new,
+    );
+}
+
+fn bench_keys<K: Hash + Eq>(c: &mut Criterion, keys: &str, workload: Workload<K>) {
+    let mut group = c.benchmark_group(format!("hashmap/{}", keys));
+
+    group
+        .throughput(Throughput::Elements(KEYS as u64))
+        .warm_up_time(Duration::from_millis(500))
+        .measurement_time(Duration::from_secs(1));
+
+    workload.bench(&mut group, "std::RandomState", hash_map::RandomState::new);
+
+    for_each_family!(hasher, (&mut group, &workload));
+
+    group.finish();
+}
+
+/// Spreads the key numbers over the whole range, as distinct values.
+fn mix(i: u64) -> u64 {
+    i.wrapping_mul(0x9E37_79B9_7F4A_7C15)
+}
+
+fn bench_u64(c: &mut Criterion) {
+    bench_keys(c, "u64", Workload::new(mix));
+}
+
+fn bench_str(c: &mut Criterion) {
+    bench_keys(c, "str", Workload::new(|i| format!("user:{}", i)));
+}
+
+fn bench_uuid(c: &mut Criterion) {
+    bench_keys(
+        c,
+        "uuid",
+        Workload::new(|i| {
+            let mut uuid = (u128::from(mix(i)) << 64 | u128::from(i)).to_le_bytes();
+
+            // random UUID, version 4 variant 1
+            uuid[6] = uuid[6] & 0x0f | 0x40;
+            uuid[8] = uuid[8] & 0x3f | 0x80;
+            uuid
+        }),
+    );
+}
+
+fn bench_url(c: &mut Criterion) {
+    bench_keys(
+        c,
+        "url",
+        Workload::new(|i| {
+            format!(
+                "https://www.example.com/catalog/{}/items/{}?utm_source=newsletter&utm_medium=email&session={:016x}",
+                i % 97,
+                i,
+                mix(i)
+            )
+        }),
+    );
+}
+
+criterion_group!(benches, bench_u64, bench_str, bench_uuid, bench_url);
+criterion_main!(benches);
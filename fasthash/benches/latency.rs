@@ -0,0 +1,180 @@
+//! Per-call latency of every hash family at every key length from 0 to 128 bytes.
+//!
+//! The throughput benchmarks in `hash.rs` only sample a few sizes, which hides the
+//! branchy tail handling that dominates short keys, such as the cliffs at 16, 17,
+//! 33, 64 and 65 bytes. For each family and key length this reports
+//!
+//! * `mean`, the cost of a hash in a chain where each key depends on the previous
+//!   hash, so that consecutive calls can not overlap
+//! * `p50` and `p99`, percentiles of single calls timed between serialized
+//!   timestamp reads, less the cost of the timing itself
+//!
+//! Counts are TSC cycles on x86_64, at the nominal rather than the boosted
+//! frequency, and nanoseconds elsewhere.
+//!
+//! ```bash
+//! $ cargo bench --bench latency -- xxh3
+//! ```
+#[macro_use]
+mod common;
+
+use criterion::black_box;
+use num_traits::PrimInt;
+
+use fasthash::*;
+
+const MAX_LEN: usize = 128;
+const WARMUP: usize = 1000;
+const CHAIN: usize = 1000;
+const SAMPLES: usize = 2001;
+
+#[cfg(target_arch = "x86_64")]
+mod clock {
+    use std::arch::x86_64::{__rdtscp, _mm_lfence, _rdtsc};
+
+    pub const UNIT: &str = "cycles";
+
+    #[inline(always)]
+    pub fn start() -> u64 {
+        unsafe {
+            _mm_lfence();
+            let t = _rdtsc();
+            _mm_lfence();
+            t
+        }
+    }
+
+    #[inline(always)]
+    pub fn stop() -> u64 {
+        let mut aux = 0;
+
+        unsafe {
+            let t = __rdtscp(&mut aux);
+            _mm_lfence();
+            t
+        }
+    }
+}
+
+#[cfg(not(target_arch = "x86_64"))]
+mod clock {
+    use std::time::Instant;
+
+    pub const UNIT: &str = "ns";
+
+    lazy_static::lazy_static! {
+        static ref EPOCH: Instant = Instant::now();
+    }
+
+    #[inline(always)]
+    pub fn start() -> u64 {
+        EPOCH.elapsed().as_nanos() as u64
+    }
+
+    #[inline(always)]
+    pub fn stop() -> u64 {
+        start()
+    }
+}
+
+struct Latency {
+    mean: f64,
+    p50: u64,
+    p99: u64,
+}
+
+fn percentile(sorted: &[u64], p: usize) -> u64 {
+    sorted[(sorted.len() - 1) * p / 100]
+}
+
+/// The median cost of reading the clock, subtracted from every sample.
+fn overhead(samples: &mut Vec<u64>) -> u64 {
+    samples.clear();
+
+    for _ in 0..SAMPLES {
+        let t0 = clock::start();
+        let t1 = clock::stop();
+
+        samples.push(t1 - t0);
+    }
+
+    samples.sort_unstable();
+
+    percentile(samples, 50)
+}
+
+fn measure<H: FastHash>(data: &[u8], len: usize, overhead: u64, samples: &mut Vec<u64>) -> Latency {
+    let key = &data[..len];
+
+    for _ in 0..WARMUP {
+        black_box(H::hash(black_box(key)));
+    }
+
+    // the offset is always zero, but the compiler can not know it,
+    // so each key depends on the previous hash
+    let zero = black_box(0_usize);
+    let mut off = 0;
+
+    let t0 = clock::start();
+    for _ in 0..CHAIN {
+        let h = H::hash(&data[off..off + len]);
+
+        off = h.count_ones() as usize & zero;
+    }
+    let t1 = clock::stop();
+
+    black_box(off);
+
+    samples.clear();
+
+    for _ in 0..SAMPLES {
+        let t0 = clock::start();
+        black_box(H::hash(black_box(key)));
+        let t1 = clock::stop();
+
+        samples.push((t1 - t0).saturating_sub(overhead));
+    }
+
+    samples.sort_unstable();
+
+    Latency {
+        mean: (t1 - t0).saturating_sub(overhead) as f64 / CHAIN as f64,
+        p50: percentile(samples, 50),
+        p99: percentile(samples, 99),
+    }
+}
+
+fn bench<H: FastHash>(name: &str, filter: Option<&str>) {
+    if filter.map_or(false, |filter| !name.contains(filter)) {
+        return;
+    }
+
+    let data = (0..MAX_LEN).map(|b| b as u8).collect::<Vec<_>>();
+    let mut samples = Vec::with_capacity(SAMPLES);
+    let overhead = overhead(&mut samples);
+
+    for len in 0..=MAX_LEN {
+        let latency = measure::<H>(&data, len, overhead, &mut samples);
+
+        println!(
+            "{:<28} {:>4} {:>10.1} {:>8} {:>8}",
+            name, len, latency.mean, latency.p50, latency.p99
+        );
+    }
+}
+
+fn main() {
+    let filter = common::filter();
+
+    println!(
+        "{:<28} {:>4} {:>10} {:>8} {:>8}   ({})",
+        "family",
+        "len",
+        "mean",
+        "p50",
+        "p99",
+        clock::UNIT
+    );
+
+    for_each_family!(bench, filter.as_ref().map(|s| s.as_str()));
+}
@@ -0,0 +1,133 @@
+//! Hardware counters of every hash family at a few input sizes, from Linux `perf_event_open`.
+//!
+//! Time alone does not tell why a family is slow at some size: a low IPC points
+//! at a dependency chain or at the memory, a high IPC with many cycles at too
+//! many instructions. For each family and input size this reports, per hash,
+//!
+//! * `cycles/B`, the core cycles per input byte
+//! * `cycles` and `IPC`, the instructions retired per cycle
+//! * `br-miss`, `L1D-miss` and `LLC-miss`, the mispredicted branches and the
+//!   loads that missed the L1 data cache and the last level cache
+//!
+//! Events that the CPU or the hypervisor does not count are shown as `-`.
+//! Only user space is counted, so `perf_event_paranoid` must be at most 2.
+//!
+//! ```bash
+//! $ cargo bench --bench perf -- xxh3
+//! ```
+//!
+//! The `hash` benchmarks can also count one of these events instead of the time,
+//! with criterion's statistics, see `FASTHASH_BENCH_EVENT`.
+#[macro_use]
+mod common;
+
+#[cfg(all(
+    target_os = "linux",
+    any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")
+))]
+mod table {
+    use criterion::black_box;
+
+    use fasthash::*;
+
+    use crate::common::perf::{Counters, Event};
+
+    const KB: usize = 1024;
+    const SIZES: [usize; 8] = [7, 8, 32, 256, KB, 4 * KB, 16 * KB, 1024 * KB];
+    // bytes hashed per size, and the least number of hashes
+    const TOTAL: usize = 64 * 1024 * KB;
+    const MIN_ITERS: usize = 100;
+
+    pub struct Config {
+        pub filter: Option<String>,
+        pub counters: Counters,
+    }
+
+    fn per_hash(count: Option<u64>, iters: usize) -> String {
+        count.map_or_else(
+            || "-".to_owned(),
+            |n| format!("{:.2}", n as f64 / iters as f64),
+        )
+    }
+
+    pub fn bench<H: FastHash>(name: &str, config: &Config) {
+        if let Some(ref filter) = config.filter {
+            if !name.contains(filter.as_str()) {
+                return;
+            }
+        }
+
+        let data = (0..SIZES[SIZES.len() - 1])
+            .map(|b| b as u8)
+            .collect::<Vec<_>>();
+
+        for &size in &SIZES {
+            let key = &data[..size];
+            let iters = (TOTAL / size).max(MIN_ITERS);
+
+            for _ in 0..iters / 10 {
+                black_box(H::hash(black_box(key)));
+            }
+
+            let start = config.counters.read();
+            for _ in 0..iters {
+                black_box(H::hash(black_box(key)));
+            }
+            let counts = config.counters.read().since(&start);
+
+            let cycles = counts.get(Event::Cycles).unwrap_or_default() as f64;
+            let ipc = counts
+                .get(Event::Instructions)
+                .map_or_else(|| "-".to_owned(), |n| format!("{:.2}", n as f64 / cycles));
+
+            println!(
+                "{:<28} {:>8} {:>9.3} {:>10.1} {:>6} {:>9} {:>9} {:>9}",
+                name,
+                size,
+                cycles / (iters * size) as f64,
+                cycles / iters as f64,
+                ipc,
+                per_hash(counts.get(Event::BranchMisses), iters),
+                per_hash(counts.get(Event::L1dMisses), iters),
+                per_hash(counts.get(Event::LlcMisses), iters),
+            );
+        }
+    }
+
+    pub fn run() {
+        let counters = match Counters::new() {
+            Ok(counters) => counters,
+            Err(err) => {
+                eprintln!("can not open the hardware counters: {}", err);
+                return;
+            }
+        };
+        let config = Config {
+            filter: crate::common::filter(),
+            counters,
+        };
+
+        println!(
+            "{:<28} {:>8} {:>9} {:>10} {:>6} {:>9} {:>9} {:>9}",
+            "family", "size", "cycles/B", "cycles", "IPC", "br-miss", "L1D-miss", "LLC-miss"
+        );
+
+        for_each_family!(bench, &config);
+    }
+}
+
+#[cfg(all(
+    target_os = "linux",
+    any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")
+))]
+fn main() {
+    table::run();
+}
+
+#[cfg(not(all(
+    target_os = "linux",
+    any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")
+)))]
+fn main() {
+    eprintln!("the perf benchmark requires Linux perf_event_open");
+}
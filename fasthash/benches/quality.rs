@@ -0,0 +1,498 @@
+//! A quality suite in the spirit of SMHasher, over every hash family.
+//!
+//! Each family runs on a thread of its own, and the whole suite takes minutes.
+//! For each family this reports
+//!
+//! * `avalanche`, the worst bias of an output bit when a single input bit of
+//!   4, 8 or 16 byte keys flips, which should change it half of the time
+//! * `bic`, bit independence, the worst correlation between the changes of two
+//!   output bits for a flipped input bit of 8 byte keys, in the low 64 bits
+//! * `sparse`, collisions of all the keys of 4 to 256 bytes with only a few
+//!   bits set, such as small integers and mostly zero records
+//! * `cyclic`, collisions of keys made of a random block repeated 8 times
+//! * `differential`, collisions between random 8 byte keys and the same keys
+//!   with 1 to 3 bits flipped
+//! * `seed`, the worst bias of an output bit between the hashes of the same keys
+//!   with two random seeds, which should differ half of the time
+//!
+//! Collisions are counted over the whole hash and, for wider hashes, over its
+//! low and high 32 bits, and fail if a random function would have so many with a
+//! probability below one in a million. The keys are the same on every run, the
+//! seeds are random.
+//!
+//! Thread count defaults to the available parallelism, and may be overridden
+//! with `FASTHASH_BENCH_THREADS`.
+//!
+//! ```bash
+//! $ cargo bench --bench quality -- xxh3
+//! ```
+#[macro_use]
+mod common;
+
+use std::io::{self, Write};
+use std::mem;
+use std::sync::Mutex;
+
+use num_traits::ToPrimitive;
+
+use fasthash::*;
+
+use common::stats;
+
+const AVALANCHE_LENS: [usize; 3] = [4, 8, 16];
+const AVALANCHE_KEYS: usize = 200_000;
+// above the largest of the biases of a random function, about 1%
+const AVALANCHE_LIMIT: f64 = 0.015;
+
+const BIC_LEN: usize = 8;
+const BIC_KEYS: usize = 30_000;
+// above the largest of the correlations of a random function, about 3%
+const BIC_LIMIT: f64 = 0.045;
+
+// key length and the most bits set in a key
+const SPARSE: [(usize, usize); 4] = [(4, 5), (8, 4), (32, 3), (256, 2)];
+
+const CYCLIC_BLOCKS: [usize; 5] = [4, 5, 8, 9, 16];
+const CYCLIC_REPEATS: usize = 8;
+const CYCLIC_KEYS: usize = 200_000;
+
+const DIFF_LEN: usize = 8;
+const DIFF_BITS: usize = 3;
+const DIFF_KEYS: usize = 100;
+
+const SEED_LEN: usize = 16;
+const SEED_PAIRS: usize = 32;
+const SEED_KEYS: usize = 20_000;
+// above the largest of the biases of a random function, about 3%
+const SEED_LIMIT: f64 = 0.05;
+
+// collision counts less likely than this for a random function fail
+const P_LIMIT: f64 = 1e-6;
+
+/// SplitMix64, so that every run hashes the same keys.
+struct Rng(u64);
+
+impl Rng {
+    fn next(&mut self) -> u64 {
+        self.0 = self.0.wrapping_add(0x9E37_79B9_7F4A_7C15);
+
+        let mut z = self.0;
+        z = (z ^ (z >> 30)).wrapping_mul(0xBF58_476D_1CE4_E5B9);
+        z = (z ^ (z >> 27)).wrapping_mul(0x94D0_49BB_1331_11EB);
+        z ^ (z >> 31)
+    }
+
+    fn fill(&mut self, buf: &mut [u8]) {
+        for chunk in buf.chunks_mut(8) {
+            chunk.copy_from_slice(&self.next().to_le_bytes()[..chunk.len()]);
+        }
+    }
+}
+
+struct Outcome {
+    test: &'static str,
+    pass: bool,
+    detail: String,
+}
+
+fn bits<H: FastHash>() -> usize {
+    mem::size_of::<H::Hash>() * 8
+}
+
+fn hash<H: FastHash>(key: &[u8]) -> u128 {
+    H::hash(key).to_u128().unwrap()
+}
+
+fn flip(key: &mut [u8], bit: usize) {
+    key[bit / 8] ^= 1 << (bit % 8);
+}
+
+/// How far the rate of `n` in `total` is from one half, from 0 to 1.
+fn bias(n: u32, total: usize) -> f64 {
+    (2.0 * f64::from(n) / total as f64 - 1.0).abs()
+}
+
+/// Adds one to the count of every bit set in `d`.
+fn count_bits(mut d: u128, counts: &mut [u32]) {
+    while d != 0 {
+        counts[d.trailing_zeros() as usize] += 1;
+        d &= d - 1;
+    }
+}
+
+/// Calls `f` with every key of `len` bytes with at most `max_bits` bits set.
+fn sparse_keys<F: FnMut(&[u8])>(len: usize, max_bits: usize, mut f: F) {
+    fn next(key: &mut [u8], from: usize, left: usize, f: &mut dyn FnMut(&[u8])) {
+        f(key);
+
+        if left > 0 {
+            for bit in from..key.len() * 8 {
+                flip(key, bit);
+                next(key, bit + 1, left - 1, f);
+                flip(key, bit);
+            }
+        }
+    }
+
+    next(&mut vec![0; len], 0, max_bits, &mut f);
+}
+
+/// Checks the collisions of `hashes`, and of their low and high 32 bits if wider,
+/// and describes the least likely count.
+fn collisions(hashes: &[u128], bits: usize, keys: &str) -> (bool, f64, String) {
+    let mut checks = vec![(bits as u32, hashes.to_vec(), "")];
+
+    if bits > 32 {
+        checks.push((
+            32,
+            hashes.iter().map(|h| h & 0xFFFF_FFFF).collect(),
+            ", low 32 bits",
+        ));
+        checks.push((
+            32,
+            hashes.iter().map(|h| h >> (bits - 32)).collect(),
+            ", high 32 bits",
+        ));
+    }
+
+    checks
+        .into_iter()
+        .map(|(bits, mut values, part)| {
+            let found = stats::collisions(&mut values);
+            let expected = stats::expected_collisions(values.len(), bits);
+            let p = stats::poisson_tail(found, expected);
+
+            (
+                p >= P_LIMIT,
+                p,
+                format!(
+                    "{} collisions in {} {}, {:.1} expected{}",
+                    found,
+                    values.len(),
+                    keys,
+                    expected,
+                    part
+                ),
+            )
+        })
+        .min_by(|a, b| a.1.partial_cmp(&b.1).unwrap())
+        .unwrap()
+}
+
+/// Reduces the collision checks of a test to the least likely one.
+fn worst(test: &'static str, checks: Vec<(bool, f64, String)>) -> Outcome {
+    let (pass, _, detail) = checks
+        .into_iter()
+        .min_by(|a, b| a.1.partial_cmp(&b.1).unwrap())
+        .unwrap();
+
+    Outcome { test, pass, detail }
+}
+
+fn avalanche<H: FastHash>() -> Outcome {
+    let bits = bits::<H>();
+    let mut rng = Rng(1);
+    let mut worst = 0.0_f64;
+
+    for &len in &AVALANCHE_LENS {
+        let mut key = vec![0; len];
+        let mut flips = vec![0; len * 8 * bits];
+
+        for _ in 0..AVALANCHE_KEYS {
+            rng.fill(&mut key);
+
+            let h = hash::<H>(&key);
+
+            for (bit, counts) in flips.chunks_mut(bits).enumerate() {
+                flip(&mut key, bit);
+                count_bits(h ^ hash::<H>(&key), counts);
+                flip(&mut key, bit);
+            }
+        }
+
+        worst = flips
+            .iter()
+            .map(|&n| bias(n, AVALANCHE_KEYS))
+            .fold(worst, f64::max);
+    }
+
+    Outcome {
+        test: "avalanche",
+        pass: worst <= AVALANCHE_LIMIT,
+        detail: format!("worst bias {:.2}%", worst * 100.0),
+    }
+}
+
+fn bic<H: FastHash>() -> Outcome {
+    let outs = bits::<H>().min(64);
+    let mut rng = Rng(2);
+    let mut key = [0; BIC_LEN];
+    // the number of times that both output bits of a pair changed, per input bit,
+    // and that each bit changed on the diagonal
+    let mut both = vec![0_u32; BIC_LEN * 8 * outs * outs];
+
+    for _ in 0..BIC_KEYS {
+        rng.fill(&mut key);
+
+        let h = hash::<H>(&key);
+
+        for (bit, pairs) in both.chunks_mut(outs * outs).enumerate() {
+            flip(&mut key, bit);
+            let mut d = (h ^ hash::<H>(&key)) as u64;
+            flip(&mut key, bit);
+
+            while d != 0 {
+                let j = d.trailing_zeros() as usize;
+
+                let row = &mut pairs[j * outs..(j + 1) * outs];
+
+                d &= d - 1;
+                row[j] += 1;
+                count_bits(u128::from(d), row);
+            }
+        }
+    }
+
+    let n = BIC_KEYS as f64;
+    let worst = both
+        .chunks(outs * outs)
+        .flat_map(|pairs| {
+            (0..outs).flat_map(move |j| {
+                (j + 1..outs).map(move |k| {
+                    let (cj, ck) = (
+                        f64::from(pairs[j * outs + j]),
+                        f64::from(pairs[k * outs + k]),
+                    );
+                    let cjk = f64::from(pairs[j * outs + k]);
+                    let var = cj * (n - cj) * ck * (n - ck);
+
+                    // the phi coefficient, and a bit that always or never changes is as bad
+                    if var > 0.0 {
+                        ((n * cjk - cj * ck) / var.sqrt()).abs()
+                    } else {
+                        1.0
+                    }
+                })
+            })
+        })
+        .fold(0.0, f64::max);
+
+    Outcome {
+        test: "bic",
+        pass: worst <= BIC_LIMIT,
+        detail: format!("worst correlation {:.2}%", worst * 100.0),
+    }
+}
+
+fn sparse<H: FastHash>() -> Outcome {
+    let checks = SPARSE
+        .iter()
+        .map(|&(len, max_bits)| {
+            let mut hashes = vec![];
+
+            sparse_keys(len, max_bits, |key| hashes.push(hash::<H>(key)));
+
+            collisions(
+                &hashes,
+                bits::<H>(),
+                &format!("{} byte keys with up to {} bits", len, max_bits),
+            )
+        })
+        .collect();
+
+    worst("sparse", checks)
+}
+
+fn cyclic<H: FastHash>() -> Outcome {
+    let mut rng = Rng(3);
+    let checks = CYCLIC_BLOCKS
+        .iter()
+        .map(|&block_len| {
+            let mut block = vec![0; block_len];
+            let hashes = (0..CYCLIC_KEYS as u32)
+                .map(|i| {
+                    rng.fill(&mut block);
+                    // a bijection of the index keeps the keys distinct
+                    block[..4].copy_from_slice(&i.wrapping_mul(0x9E37_79B1).to_le_bytes());
+
+                    hash::<H>(&block.repeat(CYCLIC_REPEATS))
+                })
+                .collect::<Vec<_>>();
+
+            collisions(
+                &hashes,
+                bits::<H>(),
+                &format!("{} byte blocks x {}", block_len, CYCLIC_REPEATS),
+            )
+        })
+        .collect();
+
+    worst("cyclic", checks)
+}
+
+fn differential<H: FastHash>() -> Outcome {
+    let bits = bits::<H>();
+    let mut deltas = vec![];
+
+    sparse_keys(DIFF_LEN, DIFF_BITS, |delta| deltas.push(delta.to_vec()));
+    deltas.remove(0);
+
+    let mut rng = Rng(4);
+    let mut key = [0; DIFF_LEN];
+    let mut found = [0; 2];
+
+    for _ in 0..DIFF_KEYS {
+        rng.fill(&mut key);
+
+        let h = hash::<H>(&key);
+
+        for delta in &deltas {
+            let other = key
+                .iter()
+                .zip(delta)
+                .map(|(k, d)| k ^ d)
+                .collect::<Vec<_>>();
+            let d = h ^ hash::<H>(&other);
+
+            if d == 0 {
+                found[0] += 1;
+            }
+            if d & 0xFFFF_FFFF == 0 {
+                found[1] += 1;
+            }
+        }
+    }
+
+    let pairs = DIFF_KEYS * deltas.len();
+    let checks = [(bits, found[0], ""), (32, found[1], ", low 32 bits")]
+        .iter()
+        .take(if bits > 32 { 2 } else { 1 })
+        .map(|&(bits, found, part)| {
+            let expected = pairs as f64 / 2_f64.powi(bits as i32);
+            let p = stats::poisson_tail(found, expected);
+
+            (
+                p >= P_LIMIT,
+                p,
+                format!(
+                    "{} collisions in {} pairs up to {} bits apart, {:.3} expected{}",
+                    found, pairs, DIFF_BITS, expected, part
+                ),
+            )
+        })
+        .collect();
+
+    worst("differential", checks)
+}
+
+fn seed<H: FastHash>() -> Outcome
+where
+    H::Seed: From<Seed>,
+{
+    let bits = bits::<H>();
+    let mut rng = Rng(5);
+    let mut key = [0; SEED_LEN];
+    let mut worst = 0.0_f64;
+
+    for _ in 0..SEED_PAIRS {
+        let (s1, s2): (H::Seed, H::Seed) = (Seed::gen().into(), Seed::gen().into());
+        let mut counts = vec![0; bits];
+
+        for _ in 0..SEED_KEYS {
+            rng.fill(&mut key);
+
+            let h1 = H::hash_with_seed(&key, s1).to_u128().unwrap();
+            let h2 = H::hash_with_seed(&key, s2).to_u128().unwrap();
+
+            count_bits(h1 ^ h2, &mut counts);
+        }
+
+        worst = counts
+            .iter()
+            .map(|&n| bias(n, SEED_KEYS))
+            .fold(worst, f64::max);
+    }
+
+    Outcome {
+        test: "seed",
+        pass: worst <= SEED_LIMIT,
+        detail: format!(
+            "worst bias {:.2}% over {} seed pairs",
+            worst * 100.0,
+            SEED_PAIRS
+        ),
+    }
+}
+
+fn run<H: FastHash>() -> Vec<Outcome>
+where
+    H::Seed: From<Seed>,
+{
+    vec![
+        avalanche::<H>(),
+        bic::<H>(),
+        sparse::<H>(),
+        cyclic::<H>(),
+        differential::<H>(),
+        seed::<H>(),
+    ]
+}
+
+type Job = (&'static str, fn() -> Vec<Outcome>);
+
+fn job<H: FastHash>(name: &'static str, (filter, jobs): (Option<&str>, &mut Vec<Job>))
+where
+    H::Seed: From<Seed>,
+{
+    if filter.map_or(true, |filter| name.contains(filter)) {
+        jobs.push((name, run::<H>));
+    }
+}
+
+fn main() {
+    let filter = common::filter();
+    let threads = common::threads();
+    let mut jobs = vec![];
+
+    for_each_family!(job, (filter.as_ref().map(|s| s.as_str()), &mut jobs));
+
+    let failed = Mutex::new(vec![]);
+
+    common::run_jobs(&jobs, threads, |&(name, run)| {
+        let outcomes = run();
+        let stdout = io::stdout();
+        let mut out = stdout.lock();
+
+        for outcome in &outcomes {
+            let _ = writeln!(
+                out,
+                "{:<28} {:<12} {:<4} {}",
+                name,
+                outcome.test,
+                if outcome.pass { "pass" } else { "FAIL" },
+                outcome.detail
+            );
+        }
+
+        let tests = outcomes
+            .iter()
+            .filter(|outcome| !outcome.pass)
+            .map(|outcome| outcome.test)
+            .collect::<Vec<_>>();
+
+        if !tests.is_empty() {
+            failed.lock().unwrap().push((name, tests));
+        }
+    });
+
+    let mut failed = failed.into_inner().unwrap();
+
+    failed.sort();
+
+    println!();
+    println!("{} of {} families failed", failed.len(), jobs.len());
+
+    for (name, tests) in failed {
+        println!("  {:<28} {}", name, tests.join(", "));
+    }
+}
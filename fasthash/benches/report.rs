@@ -0,0 +1,292 @@
+//! Throughput of every hash family as machine readable results, checked against a baseline.
+//!
+//! The build scripts choose the SSE4.2, AES-NI and AVX2 code paths from the
+//! enabled features and, with `native`, from the CPU of the build machine, so a
+//! build that lost one of them still works, only slower, and `city::crc` or
+//! `metro::crc` silently disappear. Each result is recorded with the features
+//! that the build was compiled with, and the best throughput of a few rounds.
+//!
+//! * `FASTHASH_BENCH_OUTPUT` writes the results to a `.json` or `.csv` file
+//! * `FASTHASH_BENCH_BASELINE` compares them with a `.csv` file written before,
+//!   and fails if any family is slower than the baseline by more than
+//!   `FASTHASH_BENCH_THRESHOLD` percent, 10 by default, or is missing
+//!
+//! ```bash
+//! $ FASTHASH_BENCH_OUTPUT=baseline.csv cargo bench --bench report
+//! $ FASTHASH_BENCH_BASELINE=baseline.csv cargo bench --bench report
+//! ```
+#[macro_use]
+mod common;
+
+use std::collections::HashMap;
+use std::env;
+use std::fs;
+use std::io::{self, Write};
+use std::process;
+use std::time::{Duration, Instant};
+
+use criterion::black_box;
+
+use fasthash::*;
+
+const KB: usize = 1024;
+const SIZES: [usize; 6] = [16, 64, 256, KB, 16 * KB, 1024 * KB];
+const ROUNDS: usize = 5;
+const ROUND_TIME: Duration = Duration::from_millis(50);
+const DEFAULT_THRESHOLD: f64 = 10.0;
+
+struct Record {
+    algorithm: String,
+    size: usize,
+    features: String,
+    gbps: f64,
+}
+
+/// The CPU features that the crate was built with, as `+` separated names.
+fn features() -> String {
+    let features = [
+        ("aes", cfg!(any(feature = "aes", target_feature = "aes"))),
+        (
+            "sse4.1",
+            cfg!(any(feature = "sse41", target_feature = "sse4.1")),
+        ),
+        (
+            "sse4.2",
+            cfg!(any(feature = "sse42", target_feature = "sse4.2")),
+        ),
+        (
+            "pclmul",
+            cfg!(any(feature = "pclmul", target_feature = "pclmulqdq")),
+        ),
+        ("avx", cfg!(any(feature = "avx", target_feature = "avx"))),
+        ("avx2", cfg!(any(feature = "avx2", target_feature = "avx2"))),
+    ]
+    .iter()
+    .filter(|&&(_, enabled)| enabled)
+    .map(|&(name, _)| name)
+    .collect::<Vec<_>>();
+
+    if features.is_empty() {
+        "generic".to_owned()
+    } else {
+        features.join("+")
+    }
+}
+
+/// Warns about the features that this CPU has, but the build does not use.
+#[cfg(target_arch = "x86_64")]
+fn check_features(built: &str) {
+    let detected = [
+        ("aes", is_x86_feature_detected!("aes")),
+        ("sse4.1", is_x86_feature_detected!("sse4.1")),
+        ("sse4.2", is_x86_feature_detected!("sse4.2")),
+        ("pclmul", is_x86_feature_detected!("pclmulqdq")),
+        ("avx", is_x86_feature_detected!("avx")),
+        ("avx2", is_x86_feature_detected!("avx2")),
+    ];
+
+    for &(name, _) in detected.iter().filter(|&&(_, detected)| detected) {
+        if !built.split('+').any(|f| f == name) {
+            eprintln!(
+                "warning: the CPU supports {}, but the build does not use it",
+                name
+            );
+        }
+    }
+}
+
+#[cfg(not(target_arch = "x86_64"))]
+fn check_features(_built: &str) {}
+
+/// Returns the best throughput of `ROUNDS` rounds, in GB/s.
+fn measure<H: FastHash>(key: &[u8]) -> f64 {
+    let mut best = 0.0_f64;
+
+    for _ in 0..ROUNDS {
+        let start = Instant::now();
+        let mut hashed = 0;
+
+        while start.elapsed() < ROUND_TIME {
+            for _ in 0..64 {
+                black_box(H::hash(black_box(key)));
+            }
+            hashed += 64 * key.len();
+        }
+
+        best = best.max(hashed as f64 / start.elapsed().as_secs_f64() / 1e9);
+    }
+
+    best
+}
+
+fn bench<H: FastHash>(
+    name: &str,
+    (filter, features, records): (Option<&str>, &str, &mut Vec<Record>),
+) {
+    if filter.map_or(false, |filter| !name.contains(filter)) {
+        return;
+    }
+
+    let data = (0..SIZES[SIZES.len() - 1])
+        .map(|b| b as u8)
+        .collect::<Vec<_>>();
+
+    for &size in &SIZES {
+        let gbps = measure::<H>(&data[..size]);
+
+        println!("{:<28} {:>8} {:>10.3}", name, size, gbps);
+
+        records.push(Record {
+            algorithm: name.to_owned(),
+            size,
+            features: features.to_owned(),
+            gbps,
+        });
+    }
+}
+
+fn write_csv<W: Write>(mut w: W, records: &[Record]) -> io::Result<()> {
+    writeln!(w, "algorithm,size,features,gbps")?;
+
+    for r in records {
+        writeln!(w, "{},{},{},{:.4}", r.algorithm, r.size, r.features, r.gbps)?;
+    }
+
+    Ok(())
+}
+
+fn write_json<W: Write>(mut w: W, records: &[Record]) -> io::Result<()> {
+    writeln!(w, "[")?;
+
+    for (i, r) in records.iter().enumerate() {
+        writeln!(
+            w,
+            r#"  {{"algorithm": "{}", "size": {}, "features": "{}", "gbps": {:.4}}}{}"#,
+            r.algorithm,
+            r.size,
+            r.features,
+            r.gbps,
+            if i + 1 < records.len() { "," } else { "" }
+        )?;
+    }
+
+    writeln!(w, "]")
+}
+
+fn write(path: &str, records: &[Record]) -> io::Result<()> {
+    let f = io::BufWriter::new(fs::File::create(path)?);
+
+    if path.ends_with(".json") {
+        write_json(f, records)
+    } else {
+        write_csv(f, records)
+    }
+}
+
+fn read_csv(path: &str) -> io::Result<Vec<Record>> {
+    let invalid = |line: &str| {
+        io::Error::new(
+            io::ErrorKind::InvalidData,
+            format!("{}: invalid record `{}`", path, line),
+        )
+    };
+
+    fs::read_to_string(path)?
+        .lines()
+        .skip(1)
+        .filter(|line| !line.is_empty())
+        .map(|line| {
+            let fields = line.split(',').collect::<Vec<_>>();
+
+            match fields[..] {
+                [algorithm, size, features, gbps] => Ok(Record {
+                    algorithm: algorithm.to_owned(),
+                    size: size.parse().map_err(|_| invalid(line))?,
+                    features: features.to_owned(),
+                    gbps: gbps.parse().map_err(|_| invalid(line))?,
+                }),
+                _ => Err(invalid(line)),
+            }
+        })
+        .collect()
+}
+
+/// Returns the regressions of `records` against `baseline`, one line each.
+fn compare(records: &[Record], baseline: &[Record], threshold: f64, all: bool) -> Vec<String> {
+    let current = records
+        .iter()
+        .map(|r| ((r.algorithm.as_str(), r.size), r))
+        .collect::<HashMap<_, _>>();
+    let mut regressions = vec![];
+
+    for base in baseline {
+        match current.get(&(base.algorithm.as_str(), base.size)) {
+            Some(r) => {
+                let change = 100.0 * (r.gbps / base.gbps - 1.0);
+
+                if change < -threshold {
+                    regressions.push(format!(
+                        "{} {}: {:.3} GB/s, {:.1}% slower than {:.3} GB/s{}",
+                        r.algorithm,
+                        r.size,
+                        r.gbps,
+                        -change,
+                        base.gbps,
+                        if r.features != base.features {
+                            format!(", built with {} instead of {}", r.features, base.features)
+                        } else {
+                            String::new()
+                        }
+                    ));
+                }
+            }
+            // a filtered run does not measure every family
+            None if all => regressions.push(format!(
+                "{} {}: missing, the baseline was built with {}",
+                base.algorithm, base.size, base.features
+            )),
+            None => {}
+        }
+    }
+
+    regressions
+}
+
+fn main() {
+    let filter = common::filter();
+    let features = features();
+    let mut records = vec![];
+
+    check_features(&features);
+
+    println!("features: {}", features);
+    println!("{:<28} {:>8} {:>10}", "family", "size", "GB/s");
+
+    for_each_family!(
+        bench,
+        (filter.as_ref().map(|s| s.as_str()), &features, &mut records)
+    );
+
+    if let Ok(path) = env::var("FASTHASH_BENCH_OUTPUT") {
+        write(&path, &records).unwrap_or_else(|err| panic!("write {}: {}", path, err));
+    }
+
+    if let Ok(path) = env::var("FASTHASH_BENCH_BASELINE") {
+        let baseline = read_csv(&path).unwrap_or_else(|err| panic!("read {}: {}", path, err));
+        let threshold = env::var("FASTHASH_BENCH_THRESHOLD")
+            .ok()
+            .and_then(|t| t.parse().ok())
+            .unwrap_or(DEFAULT_THRESHOLD);
+        let regressions = compare(&records, &baseline, threshold, filter.is_none());
+
+        if !regressions.is_empty() {
+            eprintln!("{} regressions against {}:", regressions.len(), path);
+
+            for regression in &regressions {
+                eprintln!("  {}", regression);
+            }
+
+            process::exit(1);
+        }
+    }
+}
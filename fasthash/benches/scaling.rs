@@ -0,0 +1,121 @@
+//! Aggregate throughput of every hash family on 1 to N threads.
+//!
+//! Each thread hashes a buffer of its own, allocated and first touched by that
+//! thread, so that the threads share nothing but the memory bandwidth, the last
+//! level cache and the power budget. For each family and thread count this reports
+//!
+//! * `GB/s`, the bytes hashed by all threads per second of wall time
+//! * `efficiency`, the throughput per thread relative to a single thread, which
+//!   falls when the threads saturate the memory bandwidth, or when wide vector
+//!   instructions lower the clock of every busy core
+//!
+//! Thread counts double from 1 up to the available parallelism, which may be
+//! overridden with `FASTHASH_BENCH_THREADS`.
+//!
+//! ```bash
+//! $ FASTHASH_BENCH_THREADS=64 cargo bench --bench scaling -- xxh3
+//! ```
+#[macro_use]
+mod common;
+
+use std::iter;
+use std::sync::Barrier;
+use std::thread;
+use std::time::{Duration, Instant};
+
+use criterion::black_box;
+
+use fasthash::*;
+
+const MB: usize = 1024 * 1024;
+// larger than the share of the last level cache of a core
+const BUFFER_SIZE: usize = 16 * MB;
+const ROUNDS: usize = 16;
+
+struct Config {
+    filter: Option<String>,
+    threads: Vec<usize>,
+}
+
+impl Config {
+    fn new() -> Self {
+        let max = common::threads();
+        let mut threads = iter::successors(Some(1), |n| Some(n * 2))
+            .take_while(|&n| n < max)
+            .collect::<Vec<_>>();
+
+        threads.push(max);
+
+        Config {
+            filter: common::filter(),
+            threads,
+        }
+    }
+}
+
+/// Returns the wall time for `threads` threads to hash their buffers `ROUNDS` times.
+fn run<H: FastHash>(threads: usize) -> Duration {
+    let barrier = Barrier::new(threads + 1);
+
+    thread::scope(|s| {
+        for _ in 0..threads {
+            s.spawn(|| {
+                let data = (0..BUFFER_SIZE).map(|b| b as u8).collect::<Vec<_>>();
+
+                black_box(H::hash(&data));
+
+                barrier.wait();
+
+                for _ in 0..ROUNDS {
+                    black_box(H::hash(black_box(&data)));
+                }
+
+                barrier.wait();
+            });
+        }
+
+        barrier.wait();
+        let start = Instant::now();
+        barrier.wait();
+
+        start.elapsed()
+    })
+}
+
+fn bench<H: FastHash>(name: &str, config: &Config) {
+    if let Some(ref filter) = config.filter {
+        if !name.contains(filter.as_str()) {
+            return;
+        }
+    }
+
+    let mut single = 0.0;
+
+    for &threads in &config.threads {
+        let elapsed = run::<H>(threads);
+        let gbps = (threads * ROUNDS * BUFFER_SIZE) as f64 / elapsed.as_secs_f64() / 1e9;
+
+        if threads == 1 {
+            single = gbps;
+        }
+
+        println!(
+            "{:<28} {:>7} {:>10.2} {:>10.1}%",
+            name,
+            threads,
+            gbps,
+            100.0 * gbps / (single * threads as f64)
+        );
+    }
+}
+
+fn main() {
+    let config = Config::new();
+
+    println!(
+        "{:<28} {:>7} {:>10} {:>11}",
+        "family", "threads", "GB/s", "efficiency"
+    );
+
+    for_each_family!(bench, &config);
+}
@@ -12,6 +12,9 @@ fn main() {
             if features.has_sse42() {
                 println!(r#"cargo:rustc-cfg=feature="sse42""#);
             }
+            if features.has_pclmulqdq() {
+                println!(r#"cargo:rustc-cfg=feature="pclmul""#);
+            }
             if features.has_avx() {
                 println!(r#"cargo:rustc-cfg=feature="avx""#);
             }
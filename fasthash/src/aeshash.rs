@@ -0,0 +1,125 @@
+//! `AesHash`, a short-key hash built from AES encryption rounds
+//!
+//! One round of the AES `aesenc` instruction mixes 16 bytes with a latency of
+//! about four cycles, which makes it a cheap mixing primitive for hash table
+//! keys, the same idea as [aHash](https://github.com/tkaitchuck/aHash) and
+//! [Meow hash](https://github.com/cmuratori/meow_hash).
+//!
+//! * Keys up to 64 bytes are read as at most four overlapping 16-byte blocks
+//!   and hashed without a loop, in three dependent AES rounds
+//! * Longer keys are mixed into four independent lanes, 64 bytes at a time
+//! * AES-NI is detected at runtime, unless the crate is built with the `aes` feature
+//! * Without AES-NI, the rounds are computed in software with the same result,
+//!   so the hash does not depend on the CPU it runs on, only the speed does
+//!
+//! `AesHash` is not a cryptographic hash and makes no claims of `HashDoS` resistance.
+//!
+//! # Example
+//!
+//! ```
+//! use std::hash::{Hash, Hasher};
+//!
+//! use fasthash::{aeshash, AesHasher};
+//!
+//! fn hash<T: Hash>(t: &T) -> u64 {
+//!     let mut s: AesHasher = Default::default();
+//!     t.hash(&mut s);
+//!     s.finish()
+//! }
+//!
+//! let h = aeshash::hash64(b"hello world\xff");
+//!
+//! assert_eq!(h, hash(&"hello world"));
+//! ```
+//!
+use std::os::raw::c_void;
+
+use crate::ffi;
+
+use crate::hasher::FastHash;
+
+/// `AesHash` 64-bit hash functions
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{aeshash::Hash64, FastHash};
+///
+/// assert_eq!(Hash64::hash(b"hello"), 13824809491448125038);
+/// assert_eq!(Hash64::hash_with_seed(b"hello", 123), 9373317346264490548);
+/// assert_eq!(Hash64::hash(b"helloworld"), 9811574046686831253);
+/// ```
+#[derive(Clone, Default)]
+pub struct Hash64;
+
+impl FastHash for Hash64 {
+    type Hash = u64;
+    type Seed = u64;
+
+    #[inline(always)]
+    fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
+        unsafe {
+            ffi::aeshash64(
+                bytes.as_ref().as_ptr() as *const c_void,
+                bytes.as_ref().len(),
+                seed,
+            )
+        }
+    }
+}
+
+trivial_hasher! {
+    /// # Example
+    ///
+    /// ```
+    /// use std::hash::Hasher;
+    ///
+    /// use fasthash::{aeshash::Hasher64, FastHasher};
+    ///
+    /// let mut h = Hasher64::new();
+    ///
+    /// h.write(b"hello");
+    /// assert_eq!(h.finish(), 13824809491448125038);
+    ///
+    /// h.write(b"world");
+    /// assert_eq!(h.finish(), 9811574046686831253);
+    /// ```
+    Hasher64(Hash64) -> u64
+}
+
+/// `AesHash` 64-bit hash functions for a byte array.
+#[inline(always)]
+pub fn hash64<T: AsRef<[u8]>>(v: T) -> u64 {
+    Hash64::hash(v)
+}
+
+/// `AesHash` 64-bit hash function for a byte array.
+/// For convenience, a 64-bit seed is also hashed into the result.
+#[inline(always)]
+pub fn hash64_with_seed<T: AsRef<[u8]>>(v: T, seed: u64) -> u64 {
+    Hash64::hash_with_seed(v, seed)
+}
+
+#[cfg(test)]
+mod tests {
+    use std::os::raw::c_void;
+
+    use crate::ffi;
+
+    use super::*;
+
+    #[test]
+    fn test_software_rounds_match_aesni() {
+        let data = (0..600_u32)
+            .map(|i| i.wrapping_mul(2_654_435_761) as u8)
+            .collect::<Vec<_>>();
+
+        for len in 0..data.len() {
+            let soft = unsafe { ffi::aeshash64_soft(data.as_ptr() as *const c_void, len, 123) };
+
+            assert_eq!(hash64_with_seed(&data[..len], 123), soft, "len = {}", len);
+        }
+    }
+}
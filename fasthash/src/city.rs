@@ -121,6 +121,7 @@
 //! ```
 //!
 use std::mem;
+use std::os::raw::c_void;
 
 use crate::ffi;
 
@@ -146,6 +147,8 @@ impl FastHash for Hash32 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::CityHash32WithSeed(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -201,6 +204,8 @@ impl Hash64 {
     /// For convenience, seeds are also hashed into the result.
     #[inline(always)]
     pub fn hash_with_seeds<T: AsRef<[u8]>>(bytes: T, seed0: u64, seed1: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::CityHash64WithSeeds(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -218,6 +223,8 @@ impl FastHash for Hash64 {
 
     #[inline(always)]
     fn hash<T: AsRef<[u8]>>(bytes: T) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe { ffi::CityHash64(bytes.as_ref().as_ptr() as *const i8, bytes.as_ref().len()) }
     }
 
@@ -225,6 +232,8 @@ impl FastHash for Hash64 {
     /// For convenience, a seed is also hashed into the result.
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::CityHash64WithSeed(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -283,6 +292,8 @@ impl FastHash for Hash128 {
 
     #[inline(always)]
     fn hash<T: AsRef<[u8]>>(bytes: T) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             mem::transmute(ffi::CityHash128(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -293,6 +304,8 @@ impl FastHash for Hash128 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u128) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             mem::transmute(ffi::CityHash128WithSeed(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -359,6 +372,8 @@ pub mod crc {
 
         #[inline(always)]
         fn hash<T: AsRef<[u8]>>(bytes: T) -> u128 {
+            record_hash!(bytes.as_ref().len());
+
             unsafe {
                 mem::transmute(ffi::CityHashCrc128(
                     bytes.as_ref().as_ptr() as *const i8,
@@ -369,6 +384,8 @@ pub mod crc {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u128) -> u128 {
+            record_hash!(bytes.as_ref().len());
+
             unsafe {
                 mem::transmute(ffi::CityHashCrc128WithSeed(
                     bytes.as_ref().as_ptr() as *const i8,
@@ -435,6 +452,86 @@ pub fn hash64_with_seeds<T: AsRef<[u8]>>(v: T, seed0: u64, seed1: u64) -> u64 {
     Hash64::hash_with_seeds(v, seed0, seed1)
 }
 
+/// `CityHash` 64-bit hash function for a fixed-length array.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash64`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::city;
+///
+/// let key = [7_u8; 12];
+///
+/// assert_eq!(city::hash_array(&key), city::hash64(&key));
+/// ```
+#[inline(always)]
+pub fn hash_array<const N: usize>(v: &[u8; N]) -> u64 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::CityHash64_fixed4(p),
+            8 => ffi::CityHash64_fixed8(p),
+            12 => ffi::CityHash64_fixed12(p),
+            16 => ffi::CityHash64_fixed16(p),
+            20 => ffi::CityHash64_fixed20(p),
+            24 => ffi::CityHash64_fixed24(p),
+            32 => ffi::CityHash64_fixed32(p),
+            64 => ffi::CityHash64_fixed64(p),
+            _ => return hash64(&v[..]),
+        }
+    };
+
+    record_hash!(Hash64, N);
+
+    h
+}
+
+/// `CityHash` 64-bit hash function for a fixed-length array.
+///
+/// For convenience, a 64-bit seed is also hashed into the result.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash64_with_seed`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::city;
+///
+/// let key = [7_u8; 24];
+///
+/// assert_eq!(city::hash_array_with_seed(&key, 123), city::hash64_with_seed(&key, 123));
+/// ```
+#[inline(always)]
+pub fn hash_array_with_seed<const N: usize>(v: &[u8; N], seed: u64) -> u64 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::CityHash64WithSeed_fixed4(p, seed),
+            8 => ffi::CityHash64WithSeed_fixed8(p, seed),
+            12 => ffi::CityHash64WithSeed_fixed12(p, seed),
+            16 => ffi::CityHash64WithSeed_fixed16(p, seed),
+            20 => ffi::CityHash64WithSeed_fixed20(p, seed),
+            24 => ffi::CityHash64WithSeed_fixed24(p, seed),
+            32 => ffi::CityHash64WithSeed_fixed32(p, seed),
+            64 => ffi::CityHash64WithSeed_fixed64(p, seed),
+            _ => return hash64_with_seed(&v[..], seed),
+        }
+    };
+
+    record_hash!(Hash64, N);
+
+    h
+}
+
 cfg_if! {
     if #[cfg(any(feature = "sse42", target_feature = "sse4.2"))] {
         /// `CityHash` 128-bit hash function for a byte array using HW CRC instruction.
@@ -469,3 +566,37 @@ cfg_if! {
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn check_hash_array<const N: usize>() {
+        let mut key = [0_u8; N];
+
+        for (i, b) in key.iter_mut().enumerate() {
+            *b = (i * 31) as u8;
+        }
+
+        assert_eq!(hash_array(&key), hash64(&key[..]), "N = {}", N);
+        assert_eq!(
+            hash_array_with_seed(&key, 42),
+            hash64_with_seed(&key[..], 42),
+            "N = {}",
+            N
+        );
+    }
+
+    #[test]
+    fn test_hash_array_matches_slice() {
+        check_hash_array::<4>();
+        check_hash_array::<8>();
+        check_hash_array::<12>();
+        check_hash_array::<16>();
+        check_hash_array::<20>();
+        check_hash_array::<24>();
+        check_hash_array::<32>();
+        check_hash_array::<64>();
+        check_hash_array::<7>();
+    }
+}
@@ -0,0 +1,246 @@
+//! `CRC-32C` (Castagnoli), a combinable checksum
+//!
+//! https://tools.ietf.org/html/rfc3720#appendix-B.4
+//!
+//! `CRC-32C` is computed with the SSE4.2 `crc32` instruction when the crate is
+//! built with SSE 4.2 support, the same as `metro::crc` and `city::crc`,
+//! and with a slicing-by-8 table otherwise.
+//!
+//! The `crc32` instruction has a latency of three cycles but a throughput of one,
+//! so long inputs are split into three interleaved streams that are checksummed
+//! together and joined by shifting the partial results over the bytes that follow.
+//! The shift is a single carry-less multiply with the `pclmul` feature,
+//! and a table lookup otherwise.
+//!
+//! Unlike the other hash functions in this crate, the checksums of two adjacent
+//! chunks can be combined into the checksum of their concatenation without
+//! reading the data again, so a large file or a multi-part upload can be
+//! checksummed in parallel and joined afterwards.
+//!
+//! # Example
+//!
+//! ```
+//! use fasthash::crc32c;
+//!
+//! let (a, b) = (b"hello", b"world");
+//!
+//! let crc_a = crc32c::hash32(a);
+//! let crc_b = crc32c::hash32(b);
+//!
+//! assert_eq!(
+//!     crc32c::combine(crc_a, crc_b, b.len() as u64),
+//!     crc32c::hash32(b"helloworld")
+//! );
+//! ```
+//!
+use std::hash::Hasher;
+use std::io::IoSlice;
+
+use crate::ffi;
+
+use crate::hasher::{FastHash, FastHasher, StreamHasher};
+
+/// `CRC-32C` checksum of a byte array.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::crc32c;
+///
+/// assert_eq!(crc32c::hash32(b"123456789"), 0xE306_9283);
+/// ```
+#[inline(always)]
+pub fn hash32<T: AsRef<[u8]>>(v: T) -> u32 {
+    Hash32::hash(v)
+}
+
+/// `CRC-32C` checksum of a byte array, continuing from the checksum of the preceding bytes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::crc32c;
+///
+/// assert_eq!(
+///     crc32c::hash32_with_seed(b"world", crc32c::hash32(b"hello")),
+///     crc32c::hash32(b"helloworld")
+/// );
+/// ```
+#[inline(always)]
+pub fn hash32_with_seed<T: AsRef<[u8]>>(v: T, seed: u32) -> u32 {
+    Hash32::hash_with_seed(v, seed)
+}
+
+/// Combines the checksums of two adjacent chunks into the checksum of their concatenation.
+///
+/// `crc1` is the checksum of the first chunk, `crc2` the checksum of the second chunk,
+/// and `len2` the length of the second chunk in bytes, which may exceed the address space,
+/// for example for a file checksummed in parts on a 32-bit target.
+/// The cost is `O(log len2)`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::crc32c;
+///
+/// let data = vec![7_u8; 10_000];
+/// let (head, tail) = data.split_at(3_000);
+///
+/// assert_eq!(
+///     crc32c::combine(crc32c::hash32(head), crc32c::hash32(tail), tail.len() as u64),
+///     crc32c::hash32(&data)
+/// );
+/// ```
+#[inline(always)]
+pub fn combine(crc1: u32, crc2: u32, len2: u64) -> u32 {
+    unsafe { ffi::crc32c_combine(crc1, crc2, len2) }
+}
+
+/// `CRC-32C` checksum functions
+///
+/// The seed is the checksum of the preceding bytes, `0` for none.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{crc32c::Hash32, FastHash};
+///
+/// assert_eq!(Hash32::hash(b"hello"), 2591144780);
+/// assert_eq!(Hash32::hash_with_seed(b"world", 2591144780), 1456190592);
+/// assert_eq!(Hash32::hash(b"helloworld"), 1456190592);
+/// ```
+#[derive(Clone, Default)]
+pub struct Hash32;
+
+impl FastHash for Hash32 {
+    type Hash = u32;
+    type Seed = u32;
+
+    #[inline(always)]
+    fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        let bytes = bytes.as_ref();
+
+        record_hash!(bytes.len());
+
+        unsafe { ffi::crc32c_update(seed, bytes.as_ptr() as *const _, bytes.len()) }
+    }
+
+    #[inline(always)]
+    fn hash_vectored(bufs: &[IoSlice]) -> u32 {
+        Self::hash_vectored_with_seed(bufs, 0)
+    }
+
+    /// Each buffer is checksummed in place, continuing from the previous one.
+    #[inline(always)]
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: u32) -> u32 {
+        record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+        bufs.iter().fold(seed, |crc, buf| unsafe {
+            ffi::crc32c_update(crc, buf.as_ptr() as *const _, buf.len())
+        })
+    }
+}
+
+/// An implementation of `std::hash::Hasher`.
+///
+/// The state is kept inline, and two hashers over adjacent chunks
+/// can be joined with `combine`.
+///
+/// # Example
+///
+/// ```
+/// use std::hash::Hasher;
+/// use std::io::Cursor;
+///
+/// use fasthash::{crc32c::Hasher32, FastHasher, StreamHasher};
+///
+/// let mut h = Hasher32::new();
+///
+/// h.write(b"hello");
+/// assert_eq!(h.finish(), 2591144780);
+///
+/// h.write(b"world");
+/// assert_eq!(h.finish(), 1456190592);
+///
+/// h.write_stream(&mut Cursor::new(&[0_u8; 4567][..])).unwrap();
+/// assert_eq!(h.finish(), 3120212721);
+/// ```
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct Hasher32 {
+    crc: u32,
+    len: u64,
+}
+
+impl Hasher32 {
+    /// Returns the number of bytes written so far.
+    #[inline(always)]
+    pub fn len(&self) -> u64 {
+        self.len
+    }
+
+    /// Returns `true` if nothing was written.
+    #[inline(always)]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Returns the checksum of the bytes written so far.
+    #[inline(always)]
+    pub fn checksum(&self) -> u32 {
+        self.crc
+    }
+
+    /// Appends the bytes hashed by `other`, as if they had been written to this hasher.
+    ///
+    /// `other` must have been constructed without a seed.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use std::hash::Hasher;
+    ///
+    /// use fasthash::{crc32c::Hasher32, FastHasher};
+    ///
+    /// let mut head = Hasher32::new();
+    /// let mut tail = Hasher32::new();
+    ///
+    /// head.write(b"hello");
+    /// tail.write(b"world");
+    /// head.combine(&tail);
+    ///
+    /// assert_eq!(head.finish(), 1456190592);
+    /// assert_eq!(head.len(), 10);
+    /// ```
+    #[inline(always)]
+    pub fn combine(&mut self, other: &Hasher32) {
+        self.crc = combine(self.crc, other.crc, other.len);
+        self.len += other.len;
+    }
+}
+
+impl Hasher for Hasher32 {
+    #[inline(always)]
+    fn finish(&self) -> u64 {
+        u64::from(self.crc)
+    }
+
+    #[inline(always)]
+    fn write(&mut self, bytes: &[u8]) {
+        self.crc = unsafe { ffi::crc32c_update(self.crc, bytes.as_ptr() as *const _, bytes.len()) };
+        self.len += bytes.len() as u64;
+    }
+}
+
+impl FastHasher for Hasher32 {
+    type Seed = u32;
+    type Output = u32;
+
+    #[inline(always)]
+    fn with_seed(seed: u32) -> Self {
+        Hasher32 { crc: seed, len: 0 }
+    }
+}
+
+impl StreamHasher for Hasher32 {}
+
+impl_build_hasher!(Hasher32, Hash32);
@@ -119,6 +119,7 @@
 //! ```
 //!
 use std::mem;
+use std::os::raw::c_void;
 
 use crate::ffi;
 
@@ -144,11 +145,15 @@ impl FastHash for Hash32 {
 
     #[inline(always)]
     fn hash<T: AsRef<[u8]>>(bytes: T) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe { ffi::farmhash32(bytes.as_ref().as_ptr() as *const i8, bytes.as_ref().len()) }
     }
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::farmhash32_with_seed(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -204,6 +209,8 @@ impl Hash64 {
     /// For convenience, seeds are also hashed into the result.
     #[inline(always)]
     pub fn hash_with_seeds<T: AsRef<[u8]>>(bytes: T, seed0: u64, seed1: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::farmhash64_with_seeds(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -221,11 +228,15 @@ impl FastHash for Hash64 {
 
     #[inline(always)]
     fn hash<T: AsRef<[u8]>>(bytes: T) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe { ffi::farmhash64(bytes.as_ref().as_ptr() as *const i8, bytes.as_ref().len()) }
     }
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::farmhash64_with_seed(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -284,6 +295,8 @@ impl FastHash for Hash128 {
 
     #[inline(always)]
     fn hash<T: AsRef<[u8]>>(bytes: T) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             mem::transmute(ffi::farmhash128(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -294,6 +307,8 @@ impl FastHash for Hash128 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u128) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             mem::transmute(ffi::farmhash128_with_seed(
                 bytes.as_ref().as_ptr() as *const i8,
@@ -369,6 +384,85 @@ pub fn hash64_with_seeds<T: AsRef<[u8]>>(v: T, seed0: u64, seed1: u64) -> u64 {
     Hash64::hash_with_seeds(v, seed0, seed1)
 }
 
+/// `FarmHash` 64-bit hash function for a fixed-length array.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash64`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::farm;
+///
+/// let key = [7_u8; 12];
+///
+/// assert_eq!(farm::hash_array(&key), farm::hash64(&key));
+/// ```
+#[inline(always)]
+pub fn hash_array<const N: usize>(v: &[u8; N]) -> u64 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::farmhash64_fixed4(p),
+            8 => ffi::farmhash64_fixed8(p),
+            12 => ffi::farmhash64_fixed12(p),
+            16 => ffi::farmhash64_fixed16(p),
+            20 => ffi::farmhash64_fixed20(p),
+            24 => ffi::farmhash64_fixed24(p),
+            32 => ffi::farmhash64_fixed32(p),
+            64 => ffi::farmhash64_fixed64(p),
+            _ => return hash64(&v[..]),
+        }
+    };
+
+    record_hash!(Hash64, N);
+
+    h
+}
+
+/// `FarmHash` 64-bit hash function for a fixed-length array.
+/// For convenience, a 64-bit seed is also hashed into the result.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash64_with_seed`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::farm;
+///
+/// let key = [7_u8; 24];
+///
+/// assert_eq!(farm::hash_array_with_seed(&key, 123), farm::hash64_with_seed(&key, 123));
+/// ```
+#[inline(always)]
+pub fn hash_array_with_seed<const N: usize>(v: &[u8; N], seed: u64) -> u64 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::farmhash64_with_seed_fixed4(p, seed),
+            8 => ffi::farmhash64_with_seed_fixed8(p, seed),
+            12 => ffi::farmhash64_with_seed_fixed12(p, seed),
+            16 => ffi::farmhash64_with_seed_fixed16(p, seed),
+            20 => ffi::farmhash64_with_seed_fixed20(p, seed),
+            24 => ffi::farmhash64_with_seed_fixed24(p, seed),
+            32 => ffi::farmhash64_with_seed_fixed32(p, seed),
+            64 => ffi::farmhash64_with_seed_fixed64(p, seed),
+            _ => return hash64_with_seed(&v[..], seed),
+        }
+    };
+
+    record_hash!(Hash64, N);
+
+    h
+}
+
 /// `FarmHash` 128-bit hash function for a byte array.
 ///
 /// May change from time to time, may differ on different platforms, may differ depending on NDEBUG.
@@ -399,6 +493,8 @@ pub fn hash128_with_seed<T: AsRef<[u8]>>(v: T, seed: u128) -> u128 {
 /// ```
 #[inline(always)]
 pub fn fingerprint32<T: AsRef<[u8]>>(v: T) -> u32 {
+    record_hash!("farm::fingerprint32", v.as_ref().len());
+
     unsafe { ffi::farmhash_fingerprint32(v.as_ref().as_ptr() as *const i8, v.as_ref().len()) }
 }
 
@@ -413,6 +509,8 @@ pub fn fingerprint32<T: AsRef<[u8]>>(v: T) -> u32 {
 /// ```
 #[inline(always)]
 pub fn fingerprint64<T: AsRef<[u8]>>(v: T) -> u64 {
+    record_hash!("farm::fingerprint64", v.as_ref().len());
+
     unsafe { ffi::farmhash_fingerprint64(v.as_ref().as_ptr() as *const i8, v.as_ref().len()) }
 }
 
@@ -427,6 +525,8 @@ pub fn fingerprint64<T: AsRef<[u8]>>(v: T) -> u64 {
 /// ```
 #[inline(always)]
 pub fn fingerprint128<T: AsRef<[u8]>>(v: T) -> u128 {
+    record_hash!("farm::fingerprint128", v.as_ref().len());
+
     unsafe {
         mem::transmute(ffi::farmhash_fingerprint128(
             v.as_ref().as_ptr() as *const i8,
@@ -451,6 +551,7 @@ impl Fingerprint<u64> for u128 {
 
 #[cfg(test)]
 mod tests {
+    use super::*;
     use crate::hasher::Fingerprint;
 
     #[test]
@@ -458,4 +559,33 @@ mod tests {
         assert_eq!(123u64.fingerprint(), 4781265650859502840);
         assert_eq!(123u128.fingerprint(), 4011577241381678309);
     }
+
+    fn check_hash_array<const N: usize>() {
+        let mut key = [0_u8; N];
+
+        for (i, b) in key.iter_mut().enumerate() {
+            *b = (i * 31) as u8;
+        }
+
+        assert_eq!(hash_array(&key), hash64(&key[..]), "N = {}", N);
+        assert_eq!(
+            hash_array_with_seed(&key, 42),
+            hash64_with_seed(&key[..], 42),
+            "N = {}",
+            N
+        );
+    }
+
+    #[test]
+    fn test_hash_array_matches_slice() {
+        check_hash_array::<4>();
+        check_hash_array::<8>();
+        check_hash_array::<12>();
+        check_hash_array::<16>();
+        check_hash_array::<20>();
+        check_hash_array::<24>();
+        check_hash_array::<32>();
+        check_hash_array::<64>();
+        check_hash_array::<7>();
+    }
 }
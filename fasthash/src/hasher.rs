@@ -1,7 +1,7 @@
 use core::cell::RefCell;
 use core::hash::{BuildHasher, Hasher};
 use core::marker::PhantomData;
-use std::io;
+use std::io::{self, IoSlice};
 
 use num_traits::PrimInt;
 use xoroshiro128::{Rng, SeedableRng, Xoroshiro128Rng};
@@ -32,6 +32,83 @@ pub trait FastHash: BuildHasherExt {
     fn hash<T: AsRef<[u8]>>(bytes: T) -> Self::Hash {
         Self::hash_with_seed(bytes, Default::default())
     }
+
+    /// Hash functions for a message scattered over several buffers,
+    /// the same as hashing their concatenation.
+    ///
+    /// A single buffer is hashed in place. Several buffers are gathered into a
+    /// reused per-thread buffer, which copies the whole message, unless the
+    /// family streams them: `xx`, `xxh3` and `highway` do from 1 KiB on, and
+    /// `crc32c` checksums each buffer in place. The other families,
+    /// `city::Hash128` among them, copy every scattered message.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use std::io::IoSlice;
+    ///
+    /// use fasthash::{city, FastHash};
+    ///
+    /// let bufs = [IoSlice::new(b"hello"), IoSlice::new(b" "), IoSlice::new(b"world")];
+    ///
+    /// assert_eq!(
+    ///     city::Hash128::hash_vectored(&bufs),
+    ///     city::Hash128::hash(b"hello world")
+    /// );
+    /// ```
+    fn hash_vectored(bufs: &[IoSlice]) -> Self::Hash {
+        gather(bufs, |bytes| Self::hash(bytes))
+    }
+
+    /// Hash functions for a message scattered over several buffers,
+    /// the same as hashing their concatenation.
+    /// For convenience, a seed is also hashed into the result.
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: Self::Seed) -> Self::Hash {
+        gather(bufs, |bytes| Self::hash_with_seed(bytes, seed))
+    }
+}
+
+// Gathered buffers larger than this are not kept for the next message.
+const GATHER_KEEP: usize = 64 * 1024;
+
+// Families with a streaming state stream scattered messages at least this long
+// instead of gathering them; below it, one copy and a one-shot hash are cheaper.
+const STREAM_VECTORED_MIN: usize = 1024;
+
+/// Returns `true` if a scattered message should be streamed rather than gathered.
+pub(crate) fn stream_vectored(bufs: &[IoSlice]) -> bool {
+    bufs.len() > 1 && bufs.iter().map(|buf| buf.len()).sum::<usize>() >= STREAM_VECTORED_MIN
+}
+
+/// Calls `f` with the concatenation of `bufs`, copying only if there is more than one.
+pub(crate) fn gather<R, F: FnOnce(&[u8]) -> R>(bufs: &[IoSlice], f: F) -> R {
+    thread_local!(static GATHER: RefCell<Vec<u8>> = RefCell::new(Vec::new()));
+
+    match bufs {
+        [] => f(&[]),
+        [buf] => f(buf),
+        _ => GATHER.with(|gathered| match gathered.try_borrow_mut() {
+            Ok(mut v) => {
+                v.clear();
+                for buf in bufs {
+                    v.extend_from_slice(buf);
+                }
+
+                let r = f(&v);
+
+                if v.capacity() > GATHER_KEEP {
+                    *v = Vec::new();
+                }
+
+                r
+            }
+            Err(_) => f(&bufs
+                .iter()
+                .flat_map(|buf| buf.iter())
+                .cloned()
+                .collect::<Vec<_>>()),
+        }),
+    }
 }
 
 /// Fast non-cryptographic hasher
@@ -58,6 +135,30 @@ where
 
     /// Constructs a new `FastHasher` with seed.
     fn with_seed(seed: Self::Seed) -> Self;
+
+    /// Writes a message scattered over several buffers,
+    /// the same as writing each buffer in turn.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use std::hash::Hasher;
+    /// use std::io::IoSlice;
+    ///
+    /// use fasthash::{xx::Hasher64, FastHasher};
+    ///
+    /// let mut h = Hasher64::new();
+    ///
+    /// h.write_vectored(&[IoSlice::new(b"hello"), IoSlice::new(b"world")]);
+    ///
+    /// assert_eq!(h.finish(), fasthash::xx::hash64(b"helloworld"));
+    /// ```
+    #[inline(always)]
+    fn write_vectored(&mut self, bufs: &[IoSlice]) {
+        for buf in bufs {
+            self.write(buf);
+        }
+    }
 }
 
 /// Hasher in the buffer mode for short key
@@ -261,6 +362,36 @@ impl<T: FastHash> Default for RandomState<T> {
     }
 }
 
+/// Counts a call of a one-shot hash function of `Self`, of `$family` outside
+/// of its `impl`, or of a function named `$name` that has no type of its own,
+/// over `$len` bytes, if the `metrics` feature is enabled; otherwise nothing is evaluated.
+#[doc(hidden)]
+#[cfg(feature = "metrics")]
+macro_rules! record_hash {
+    (@record $name:expr, $len:expr) => {{
+        static FAMILY: $crate::metrics::Family = $crate::metrics::Family::new();
+
+        FAMILY.record($name, $len);
+    }};
+    ($name:literal, $len:expr) => {
+        record_hash!(@record || $name, $len)
+    };
+    ($family:ty, $len:expr) => {
+        record_hash!(@record ::std::any::type_name::<$family>, $len)
+    };
+    ($len:expr) => {
+        record_hash!(Self, $len)
+    };
+}
+
+#[doc(hidden)]
+#[cfg(not(feature = "metrics"))]
+macro_rules! record_hash {
+    ($name:literal, $len:expr) => {};
+    ($family:ty, $len:expr) => {};
+    ($len:expr) => {};
+}
+
 #[doc(hidden)]
 macro_rules! impl_build_hasher {
     ($hasher:ident, $hash:ident) => {
@@ -425,6 +556,15 @@ macro_rules! trivial_hasher {
             fn with_seed(seed: Self::Seed) -> Self {
                 <Self as $crate::hasher::BufHasher>::with_capacity_and_seed(64, Some(seed))
             }
+
+            #[inline(always)]
+            fn write_vectored(&mut self, bufs: &[::std::io::IoSlice]) {
+                self.bytes.reserve(bufs.iter().map(|buf| buf.len()).sum());
+
+                for buf in bufs {
+                    self.bytes.extend_from_slice(buf);
+                }
+            }
         }
 
         impl ::std::convert::AsRef<[u8]> for $hasher {
@@ -537,6 +677,7 @@ mod tests {
         test_hashmap_with_hashers![city::Hash32, city::Hash64, city::Hash128];
         #[cfg(any(feature = "sse42", target_feature = "sse4.2"))]
         test_hashmap_with_hashers![city::crc::Hash128];
+        test_hashmap_with_hashers![crc32c::Hash32];
         test_hashmap_with_hashers![farm::Hash32, farm::Hash64, farm::Hash128];
         test_hashmap_with_hashers![lookup3::Hash32];
         test_hashmap_with_hashers![
@@ -18,7 +18,34 @@
 //!
 //! Statistical analyses and preliminary cryptanalysis are given in
 //! https://arxiv.org/abs/1612.06257.
-use crate::FastHash;
+//!
+//! The hashers keep the `HighwayHashCat` streaming state inline, so payloads
+//! can be hashed in pieces without buffering them, with the same result
+//! as hashing the concatenation at once.
+//!
+//! # Example
+//!
+//! ```
+//! use std::hash::Hasher;
+//! use std::io::Cursor;
+//!
+//! use fasthash::{highway, FastHasher, StreamHasher};
+//!
+//! let key = [1, 2, 3, 4];
+//! let payload = vec![0xAB_u8; 100_000];
+//! let mut h = highway::Hasher256::with_seed(key);
+//!
+//! h.write_stream(&mut Cursor::new(&payload)).unwrap();
+//!
+//! assert_eq!(h.finish256(), highway::hash256_with_seed(&payload, key));
+//! ```
+//!
+use std::hash::Hasher;
+use std::io::IoSlice;
+
+use crate::hasher::{
+    gather, stream_vectored, FastHash, FastHasher, HasherExt, StreamHasher, TrivialHasher,
+};
 
 /// 256-bit secret key that should remain unknown to attackers.
 /// We recommend initializing it to a random value.
@@ -119,6 +146,8 @@ impl FastHash for Hash64 {
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: Self::Seed) -> Self::Hash {
         let bytes = bytes.as_ref();
 
+        record_hash!(bytes.len());
+
         unsafe {
             ffi::HighwayHash64(
                 seed.as_ptr() as *mut _,
@@ -127,27 +156,87 @@ impl FastHash for Hash64 {
             )
         }
     }
+
+    #[inline(always)]
+    fn hash_vectored(bufs: &[IoSlice]) -> Self::Hash {
+        Self::hash_vectored_with_seed(bufs, Default::default())
+    }
+
+    #[inline(always)]
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: Self::Seed) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher64::with_seed(seed);
+            h.write_vectored(bufs);
+            h.finish()
+        } else {
+            gather(bufs, |bytes| Self::hash_with_seed(bytes, seed))
+        }
+    }
 }
 
-trivial_hasher! {
-    /// # Example
-    ///
-    /// ```
-    /// use std::hash::Hasher;
-    ///
-    /// use fasthash::{highway::Hasher64, FastHasher};
-    ///
-    /// let mut h = Hasher64::new();
-    ///
-    /// h.write(b"hello");
-    /// assert_eq!(h.finish(), 16088634173958985784);
-    ///
-    /// h.write(b"world");
-    /// assert_eq!(h.finish(), 14621305948273251148);
-    /// ```
-    Hasher64(Hash64) -> u64
+/// An implementation of `std::hash::Hasher`.
+///
+/// # Example
+///
+/// ```
+/// use std::hash::Hasher;
+///
+/// use fasthash::{highway::Hasher64, FastHasher};
+///
+/// let mut h = Hasher64::new();
+///
+/// h.write(b"hello");
+/// assert_eq!(h.finish(), 16088634173958985784);
+///
+/// h.write(b"world");
+/// assert_eq!(h.finish(), 14621305948273251148);
+/// ```
+#[derive(Clone)]
+pub struct Hasher64(State);
+
+impl Default for Hasher64 {
+    #[inline(always)]
+    fn default() -> Self {
+        Hasher64::new()
+    }
+}
+
+impl Hasher for Hasher64 {
+    #[inline(always)]
+    fn finish(&self) -> u64 {
+        unsafe { ffi::HighwayHashCatFinish64(&(self.0).0) }
+    }
+
+    #[inline(always)]
+    fn write(&mut self, bytes: &[u8]) {
+        self.0.append(bytes)
+    }
+}
+
+impl FastHasher for Hasher64 {
+    type Seed = Seed;
+    type Output = u64;
+
+    #[inline(always)]
+    fn with_seed(seed: Seed) -> Self {
+        Hasher64(State::new(seed))
+    }
 }
 
+impl TrivialHasher for Hasher64 {
+    #[inline(always)]
+    fn finalize(&self) -> u64 {
+        self.finish()
+    }
+}
+
+impl StreamHasher for Hasher64 {}
+
+impl_build_hasher!(Hasher64, Hash64);
+impl_digest!(Hasher64, u64);
+
 /// An implementation of `std::hash::Hasher`.
 ///
 /// # Example
@@ -170,6 +259,8 @@ impl FastHash for Hash128 {
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: Self::Seed) -> Self::Hash {
         let bytes = bytes.as_ref();
+
+        record_hash!(bytes.len());
         let mut hash: ffi::HHResult128 = [0; 2];
 
         unsafe {
@@ -183,23 +274,250 @@ impl FastHash for Hash128 {
 
         u128::from(hash[0]) + (u128::from(hash[1]) << 64)
     }
+
+    #[inline(always)]
+    fn hash_vectored(bufs: &[IoSlice]) -> Self::Hash {
+        Self::hash_vectored_with_seed(bufs, Default::default())
+    }
+
+    #[inline(always)]
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: Self::Seed) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher128::with_seed(seed);
+            h.write_vectored(bufs);
+            h.finish_ext()
+        } else {
+            gather(bufs, |bytes| Self::hash_with_seed(bytes, seed))
+        }
+    }
+}
+
+/// An implementation of `std::hash::Hasher`.
+///
+/// # Example
+///
+/// ```
+/// use std::hash::Hasher;
+///
+/// use fasthash::{highway::Hasher128, FastHasher, HasherExt};
+///
+/// let mut h = Hasher128::new();
+///
+/// h.write(b"hello");
+/// assert_eq!(h.finish_ext(), 25004695140143629173192629076022730068);
+///
+/// h.write(b"world");
+/// assert_eq!(h.finish_ext(), 11585459712122041444150834631428357454);
+/// ```
+#[derive(Clone)]
+pub struct Hasher128(State);
+
+impl Default for Hasher128 {
+    #[inline(always)]
+    fn default() -> Self {
+        Hasher128::new()
+    }
+}
+
+impl Hasher for Hasher128 {
+    #[inline(always)]
+    fn finish(&self) -> u64 {
+        self.finish_ext() as u64
+    }
+
+    #[inline(always)]
+    fn write(&mut self, bytes: &[u8]) {
+        self.0.append(bytes)
+    }
+}
+
+impl FastHasher for Hasher128 {
+    type Seed = Seed;
+    type Output = u128;
+
+    #[inline(always)]
+    fn with_seed(seed: Seed) -> Self {
+        Hasher128(State::new(seed))
+    }
 }
 
-trivial_hasher! {
-    /// # Example
-    ///
-    /// ```
-    /// use std::hash::Hasher;
-    ///
-    /// use fasthash::{highway::Hasher128, FastHasher, HasherExt};
-    ///
-    /// let mut h = Hasher128::new();
-    ///
-    /// h.write(b"hello");
-    /// assert_eq!(h.finish_ext(), 25004695140143629173192629076022730068);
-    ///
-    /// h.write(b"world");
-    /// assert_eq!(h.finish_ext(), 11585459712122041444150834631428357454);
-    /// ```
-    Hasher128(Hash128) -> u128
+impl TrivialHasher for Hasher128 {
+    #[inline(always)]
+    fn finalize(&self) -> u128 {
+        let mut hash: ffi::HHResult128 = [0; 2];
+
+        unsafe { ffi::HighwayHashCatFinish128(&(self.0).0, &mut hash) }
+
+        u128::from(hash[0]) + (u128::from(hash[1]) << 64)
+    }
+}
+
+impl StreamHasher for Hasher128 {}
+
+impl_build_hasher!(Hasher128, Hash128);
+impl_digest!(Hasher128, u128);
+
+/// `HighwayHash` 256-bit hash functions for a byte array.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::highway;
+///
+/// assert_eq!(highway::hash256("hello world"), highway::hash256_with_seed("hello world", [0; 4]));
+/// ```
+#[inline(always)]
+pub fn hash256<T: AsRef<[u8]>>(v: T) -> [u64; 4] {
+    hash256_with_seed(v, Default::default())
+}
+
+/// `HighwayHash` 256-bit hash function for a byte array.
+///
+/// For convenience, a 256-bit seed is also hashed into the result.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::highway;
+///
+/// assert_ne!(
+///     highway::hash256_with_seed("hello world", [1, 2, 3, 4]),
+///     highway::hash256("hello world")
+/// );
+/// ```
+#[inline(always)]
+pub fn hash256_with_seed<T: AsRef<[u8]>>(v: T, seed: Seed) -> [u64; 4] {
+    let bytes = v.as_ref();
+    let mut hash: ffi::HHResult256 = [0; 4];
+
+    record_hash!("highway::hash256", bytes.len());
+
+    unsafe {
+        ffi::HighwayHash256(
+            seed.as_ptr() as *mut _,
+            bytes.as_ptr() as *const _,
+            bytes.len() as u64,
+            &mut hash,
+        )
+    }
+
+    hash
+}
+
+/// A streaming `HighwayHash` hasher with a 256-bit result.
+///
+/// `finish` returns the first 64 bits of the result.
+///
+/// # Example
+///
+/// ```
+/// use std::hash::Hasher;
+///
+/// use fasthash::{highway::{self, Hasher256}, FastHasher};
+///
+/// let mut h = Hasher256::with_seed([1, 2, 3, 4]);
+///
+/// h.write(b"hello");
+/// h.write(b"world");
+///
+/// assert_eq!(h.finish256(), highway::hash256_with_seed(b"helloworld", [1, 2, 3, 4]));
+/// ```
+#[derive(Clone)]
+pub struct Hasher256(State);
+
+impl Hasher256 {
+    /// Returns the 256-bit hash of the bytes written so far.
+    #[inline(always)]
+    pub fn finish256(&self) -> [u64; 4] {
+        let mut hash: ffi::HHResult256 = [0; 4];
+
+        unsafe { ffi::HighwayHashCatFinish256(&(self.0).0, &mut hash) }
+
+        hash
+    }
+}
+
+impl Default for Hasher256 {
+    #[inline(always)]
+    fn default() -> Self {
+        Hasher256::new()
+    }
+}
+
+impl Hasher for Hasher256 {
+    #[inline(always)]
+    fn finish(&self) -> u64 {
+        self.finish256()[0]
+    }
+
+    #[inline(always)]
+    fn write(&mut self, bytes: &[u8]) {
+        self.0.append(bytes)
+    }
+}
+
+impl FastHasher for Hasher256 {
+    type Seed = Seed;
+    type Output = [u64; 4];
+
+    #[inline(always)]
+    fn with_seed(seed: Seed) -> Self {
+        Hasher256(State::new(seed))
+    }
+}
+
+impl StreamHasher for Hasher256 {}
+
+/// The `HighwayHashCat` streaming state, kept inline.
+#[derive(Clone, Copy)]
+struct State(ffi::HighwayHashCat);
+
+impl State {
+    #[inline(always)]
+    fn new(seed: Seed) -> Self {
+        let mut state = State(ffi::HighwayHashCat { state: [0; 32] });
+
+        unsafe { ffi::HighwayHashCatStart(seed.as_ptr(), &mut state.0) }
+
+        state
+    }
+
+    #[inline(always)]
+    fn append(&mut self, bytes: &[u8]) {
+        unsafe {
+            ffi::HighwayHashCatAppend(bytes.as_ptr() as *const _, bytes.len() as u64, &mut self.0)
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_streaming_matches_oneshot() {
+        let seed = [1, 2, 3, 4];
+        let data = (0..1000_u32).map(|i| (i * 7) as u8).collect::<Vec<_>>();
+
+        for &len in &[0, 1, 31, 32, 33, 64, 100, 1000] {
+            let bytes = &data[..len];
+            let mut hashers = (
+                Hasher64::with_seed(seed),
+                Hasher128::with_seed(seed),
+                Hasher256::with_seed(seed),
+            );
+
+            for chunk in bytes.chunks(13) {
+                hashers.0.write(chunk);
+                hashers.1.write(chunk);
+                hashers.2.write(chunk);
+            }
+
+            assert_eq!(hashers.0.finish(), hash64_with_seed(bytes, seed));
+            assert_eq!(hashers.1.finish_ext(), hash128_with_seed(bytes, seed));
+            assert_eq!(hashers.2.finish256(), hash256_with_seed(bytes, seed));
+        }
+    }
 }
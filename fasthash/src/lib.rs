@@ -70,19 +70,30 @@ cfg_if! {
 
 #[macro_use]
 mod hasher;
+pub mod aeshash;
 pub mod city;
+pub mod crc32c;
 pub mod farm;
 pub mod highway;
 pub mod lookup3;
+pub mod merkle;
+#[cfg(feature = "metrics")]
+pub mod metrics;
 pub mod metro;
+pub mod minhash;
+pub mod multiset;
 pub mod mum;
 pub mod murmur;
 pub mod murmur2;
 pub mod murmur3;
+pub mod prefetch;
+pub mod rapid;
 #[cfg(feature = "t1ha")]
 pub mod t1ha;
 pub mod sea;
+pub mod simhash;
 pub mod spooky;
+pub mod wy;
 pub mod xx;
 pub mod xxh3;
 
@@ -90,11 +101,13 @@ pub use crate::hasher::{
     BufHasher, FastHash, FastHasher, Fingerprint, HasherExt, RandomState, Seed, StreamHasher,
 };
 
+pub use crate::aeshash::Hasher64 as AesHasher;
 pub use crate::farm::{Hasher128 as FarmHasherExt, Hasher64 as FarmHasher};
 pub use crate::lookup3::Hasher32 as Lookup3Hasher;
 pub use crate::mum::Hasher64 as MumHasher;
 pub use crate::murmur::Hasher32 as MurmurHasher;
 pub use crate::murmur3::Hasher32 as Murmur3Hasher;
+pub use crate::rapid::Hasher64 as RapidHasher;
 #[doc(no_inline)]
 pub use crate::sea::Hasher64 as SeaHasher;
 pub use crate::spooky::{Hasher128 as SpookyHasherExt, Hasher64 as SpookyHasher};
@@ -104,6 +117,7 @@ cfg_if! {
         pub use crate::t1ha2::{Hasher128 as T1haHasherExt, Hasher128 as T1haHasher};
     }
 }
+pub use crate::wy::Hasher64 as WyHasher;
 pub use crate::xx::Hasher64 as XXHasher;
 cfg_if! {
     if #[cfg(target_pointer_width = "64")] {
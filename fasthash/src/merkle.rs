@@ -0,0 +1,451 @@
+//! Merkle trees over 128-bit `FastHash` leaves, for anti-entropy between replicas.
+//!
+//! https://en.wikipedia.org/wiki/Merkle_tree
+//!
+//! Leaves are hashed with any 128-bit family, and every interior node is the
+//! same family applied to its two children. As in RFC 6962, a leaf is hashed
+//! after a `0x00` byte and an interior node after a `0x01` byte, so a leaf
+//! can not be passed off as an interior node. An odd node at the end of a
+//! level is promoted to the next level unchanged.
+//!
+//! Changing one leaf only rehashes its path to the root, so a tree kept
+//! alongside the data can be maintained in `O(log n)` per write. Two trees
+//! over the same key range can be compared top-down, which only descends
+//! into the subtrees that differ.
+//!
+//! Note that the underlying hash functions are **not** cryptographic,
+//! so the tree detects accidental divergence, not tampering.
+//!
+//! # Example
+//!
+//! ```
+//! use fasthash::{merkle::MerkleTree, xxh3};
+//!
+//! let mut a = MerkleTree::<xxh3::Hash128>::from_leaves(&["a", "b", "c", "d", "e"]);
+//! let b = MerkleTree::<xxh3::Hash128>::from_leaves(&["a", "b", "C", "d", "e"]);
+//!
+//! assert_ne!(a.root(), b.root());
+//! assert_eq!(a.diff(&b), vec![2]);
+//!
+//! a.update(2, "C");
+//!
+//! assert_eq!(a.root(), b.root());
+//! ```
+//!
+use std::io::IoSlice;
+use std::marker::PhantomData;
+use std::thread;
+
+use crate::hasher::FastHash;
+
+const LEAF_TAG: u8 = 0;
+const NODE_TAG: u8 = 1;
+
+/// Returns the hash of a leaf, `H(0x00 || data)`.
+#[inline(always)]
+fn hash_leaf<H: FastHash<Hash = u128>>(data: &[u8]) -> u128 {
+    H::hash_vectored(&[IoSlice::new(&[LEAF_TAG]), IoSlice::new(data)])
+}
+
+#[inline(always)]
+fn combine<H: FastHash<Hash = u128>>(left: u128, right: u128) -> u128 {
+    let mut buf = [0_u8; 33];
+
+    buf[0] = NODE_TAG;
+    buf[1..17].copy_from_slice(&left.to_le_bytes());
+    buf[17..].copy_from_slice(&right.to_le_bytes());
+
+    H::hash(&buf[..])
+}
+
+/// Fills `out[i]` with `f(i)`, splitting the work across `threads` threads.
+fn par_fill<F>(out: &mut [u128], threads: usize, f: F)
+where
+    F: Fn(usize) -> u128 + Sync,
+{
+    let threads = threads.max(1).min(out.len().max(1));
+
+    if threads == 1 {
+        for (i, h) in out.iter_mut().enumerate() {
+            *h = f(i);
+        }
+        return;
+    }
+
+    let chunk = (out.len() + threads - 1) / threads;
+    let f = &f;
+
+    thread::scope(|s| {
+        for (n, part) in out.chunks_mut(chunk).enumerate() {
+            s.spawn(move || {
+                for (i, h) in part.iter_mut().enumerate() {
+                    *h = f(n * chunk + i);
+                }
+            });
+        }
+    });
+}
+
+/// A Merkle tree with 128-bit nodes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{merkle::MerkleTree, city};
+///
+/// let keys = (0..1000_u32).map(|i| i.to_le_bytes()).collect::<Vec<_>>();
+///
+/// let t = MerkleTree::<city::Hash128>::par_from_leaves(&keys, 4);
+///
+/// assert_eq!(t.len(), 1000);
+/// assert_eq!(t.root(), MerkleTree::<city::Hash128>::from_leaves(&keys).root());
+/// ```
+#[derive(Clone)]
+pub struct MerkleTree<H: FastHash<Hash = u128>> {
+    levels: Vec<Vec<u128>>,
+    phantom: PhantomData<H>,
+}
+
+impl<H: FastHash<Hash = u128>> MerkleTree<H> {
+    /// Builds a tree from already hashed leaves.
+    ///
+    /// Each hash must already be the tagged leaf hash `H(0x00 || data)`,
+    /// such as the ones returned by `leaf` or `leaves`.
+    pub fn from_leaf_hashes(leaves: Vec<u128>) -> Self {
+        Self::build(leaves, 1)
+    }
+
+    /// Builds a tree by hashing each leaf.
+    pub fn from_leaves<I, T>(leaves: I) -> Self
+    where
+        I: IntoIterator<Item = T>,
+        T: AsRef<[u8]>,
+    {
+        Self::build(
+            leaves
+                .into_iter()
+                .map(|leaf| hash_leaf::<H>(leaf.as_ref()))
+                .collect(),
+            1,
+        )
+    }
+
+    /// Builds a tree by hashing the leaves and interior levels on up to `threads` threads.
+    pub fn par_from_leaves<T>(leaves: &[T], threads: usize) -> Self
+    where
+        T: AsRef<[u8]> + Sync,
+    {
+        let mut hashes = vec![0; leaves.len()];
+
+        par_fill(&mut hashes, threads, |i| hash_leaf::<H>(leaves[i].as_ref()));
+
+        Self::build(hashes, threads)
+    }
+
+    fn build(leaves: Vec<u128>, threads: usize) -> Self {
+        // Levels smaller than this are not worth spawning threads for.
+        const PAR_THRESHOLD: usize = 4096;
+
+        let mut levels = vec![leaves];
+
+        while levels.last().unwrap().len() > 1 {
+            let prev = levels.last().unwrap();
+            let mut next = vec![0; (prev.len() + 1) / 2];
+            let threads = if next.len() >= PAR_THRESHOLD {
+                threads
+            } else {
+                1
+            };
+
+            par_fill(&mut next, threads, |i| match prev.get(2 * i + 1) {
+                Some(&right) => combine::<H>(prev[2 * i], right),
+                None => prev[2 * i],
+            });
+
+            levels.push(next);
+        }
+
+        MerkleTree {
+            levels,
+            phantom: PhantomData,
+        }
+    }
+
+    /// Returns the number of leaves.
+    #[inline(always)]
+    pub fn len(&self) -> usize {
+        self.levels[0].len()
+    }
+
+    /// Returns `true` if the tree has no leaf.
+    #[inline(always)]
+    pub fn is_empty(&self) -> bool {
+        self.levels[0].is_empty()
+    }
+
+    /// Returns the root hash, or `None` for an empty tree.
+    #[inline(always)]
+    pub fn root(&self) -> Option<u128> {
+        self.levels.last().unwrap().first().cloned()
+    }
+
+    /// Returns the tagged hash of the leaf at `index`.
+    #[inline(always)]
+    pub fn leaf(&self, index: usize) -> Option<u128> {
+        self.levels[0].get(index).cloned()
+    }
+
+    /// Extracts the tagged leaf hashes.
+    #[inline(always)]
+    pub fn leaves(&self) -> &[u128] {
+        &self.levels[0]
+    }
+
+    /// Replaces the leaf at `index` with the hash of `data`,
+    /// rehashing only its path to the root.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `index` is out of bounds.
+    #[inline(always)]
+    pub fn update<T: AsRef<[u8]>>(&mut self, index: usize, data: T) {
+        self.update_hash(index, hash_leaf::<H>(data.as_ref()))
+    }
+
+    /// Replaces the leaf at `index` with an already hashed value,
+    /// rehashing only its path to the root.
+    ///
+    /// The hash must already be the tagged leaf hash `H(0x00 || data)`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `index` is out of bounds.
+    pub fn update_hash(&mut self, index: usize, hash: u128) {
+        assert!(index < self.len(), "leaf index out of bounds");
+
+        let mut i = index;
+
+        self.levels[0][i] = hash;
+
+        for k in 1..self.levels.len() {
+            let (lower, upper) = self.levels.split_at_mut(k);
+            let prev = &lower[k - 1];
+            let left = i & !1;
+
+            i /= 2;
+            upper[0][i] = match prev.get(left + 1) {
+                Some(&right) => combine::<H>(prev[left], right),
+                None => prev[left],
+            };
+        }
+    }
+
+    /// Returns the indices of the leaves that differ between the two trees.
+    ///
+    /// Only subtrees whose roots differ are visited,
+    /// so the cost is proportional to the number of differences.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the trees have a different number of leaves.
+    pub fn diff(&self, other: &Self) -> Vec<usize> {
+        assert_eq!(self.len(), other.len(), "trees must have the same shape");
+
+        let mut diffs = Vec::new();
+        let top = self.levels.len() - 1;
+        let mut stack = if self.root() != other.root() {
+            vec![(top, 0)]
+        } else {
+            vec![]
+        };
+
+        while let Some((k, i)) = stack.pop() {
+            if k == 0 {
+                diffs.push(i);
+                continue;
+            }
+
+            for child in (2 * i..2 * i + 2).rev() {
+                if let (Some(a), Some(b)) = (
+                    self.levels[k - 1].get(child),
+                    other.levels[k - 1].get(child),
+                ) {
+                    if a != b {
+                        stack.push((k - 1, child));
+                    }
+                }
+            }
+        }
+
+        diffs
+    }
+
+    /// Returns the inclusion proof of the leaf at `index`.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use fasthash::{merkle::MerkleTree, xxh3};
+    ///
+    /// let t = MerkleTree::<xxh3::Hash128>::from_leaves(&["a", "b", "c"]);
+    /// let p = t.proof(2).unwrap();
+    ///
+    /// assert!(p.verify(t.root().unwrap(), "c"));
+    /// assert!(!p.verify(t.root().unwrap(), "x"));
+    /// ```
+    pub fn proof(&self, index: usize) -> Option<MerkleProof<H>> {
+        if index >= self.len() {
+            return None;
+        }
+
+        let mut i = index;
+        let mut path = Vec::with_capacity(self.levels.len());
+
+        for level in &self.levels[..self.levels.len() - 1] {
+            let sibling = i ^ 1;
+
+            if let Some(&h) = level.get(sibling) {
+                path.push((h, sibling < i));
+            }
+
+            i /= 2;
+        }
+
+        Some(MerkleProof {
+            index,
+            path,
+            phantom: PhantomData,
+        })
+    }
+}
+
+/// An inclusion proof of one leaf, as the sibling hashes from the leaf to the root.
+#[derive(Clone)]
+pub struct MerkleProof<H: FastHash<Hash = u128>> {
+    index: usize,
+    path: Vec<(u128, bool)>,
+    phantom: PhantomData<H>,
+}
+
+impl<H: FastHash<Hash = u128>> MerkleProof<H> {
+    /// Returns the index of the proven leaf.
+    #[inline(always)]
+    pub fn index(&self) -> usize {
+        self.index
+    }
+
+    /// Returns the sibling hashes, each flagged `true` if it is the left child.
+    #[inline(always)]
+    pub fn path(&self) -> &[(u128, bool)] {
+        &self.path
+    }
+
+    /// Checks that `data` is the proven leaf of the tree with the given `root`.
+    #[inline(always)]
+    pub fn verify<T: AsRef<[u8]>>(&self, root: u128, data: T) -> bool {
+        self.verify_hash(root, hash_leaf::<H>(data.as_ref()))
+    }
+
+    /// Checks that an already hashed leaf is the proven leaf of the tree with the given `root`.
+    ///
+    /// The hash must already be the tagged leaf hash `H(0x00 || data)`.
+    pub fn verify_hash(&self, root: u128, leaf: u128) -> bool {
+        let h = self.path.iter().fold(leaf, |h, &(sibling, is_left)| {
+            if is_left {
+                combine::<H>(sibling, h)
+            } else {
+                combine::<H>(h, sibling)
+            }
+        });
+
+        h == root
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::xxh3;
+
+    type Tree = MerkleTree<xxh3::Hash128>;
+
+    fn keys(n: u32) -> Vec<[u8; 4]> {
+        (0..n).map(|i| i.to_le_bytes()).collect()
+    }
+
+    #[test]
+    fn test_empty_and_single() {
+        let t = Tree::from_leaves(Vec::<&[u8]>::new());
+
+        assert!(t.is_empty());
+        assert_eq!(t.root(), None);
+        assert!(t.proof(0).is_none());
+
+        let t = Tree::from_leaves(&["a"]);
+
+        assert_eq!(t.root(), Some(xxh3::Hash128::hash(b"\x00a")));
+        assert!(t.proof(0).unwrap().verify(t.root().unwrap(), "a"));
+    }
+
+    #[test]
+    fn test_incremental_update() {
+        for &n in &[2, 3, 7, 8, 9, 100, 1025] {
+            let mut data = keys(n);
+            let mut t = Tree::from_leaves(&data);
+
+            for &i in &[0, n as usize / 2, n as usize - 1] {
+                data[i] = [0xFF; 4];
+                t.update(i, data[i]);
+
+                assert_eq!(t.root(), Tree::from_leaves(&data).root());
+            }
+        }
+    }
+
+    #[test]
+    fn test_parallel_build() {
+        let data = keys(10_000);
+
+        assert_eq!(
+            Tree::par_from_leaves(&data, 8).root(),
+            Tree::from_leaves(&data).root()
+        );
+    }
+
+    #[test]
+    fn test_diff_and_proof() {
+        let a = keys(1000);
+        let mut b = a.clone();
+
+        b[3] = [0; 4];
+        b[999] = [1; 4];
+
+        let (ta, tb) = (Tree::from_leaves(&a), Tree::from_leaves(&b));
+
+        assert_eq!(ta.diff(&tb), vec![3, 999]);
+        assert!(ta.diff(&ta).is_empty());
+
+        let root = ta.root().unwrap();
+
+        for i in 0..a.len() {
+            let p = ta.proof(i).unwrap();
+
+            assert!(p.verify(root, a[i]));
+            assert_eq!(p.verify(root, b[i]), a[i] == b[i]);
+        }
+    }
+
+    #[test]
+    fn test_leaf_is_not_a_node() {
+        let t = Tree::from_leaves(&["a", "b"]);
+
+        // the preimage of the root, passed off as a single leaf
+        let mut forged = vec![NODE_TAG];
+
+        forged.extend_from_slice(&t.leaf(0).unwrap().to_le_bytes());
+        forged.extend_from_slice(&t.leaf(1).unwrap().to_le_bytes());
+
+        assert_ne!(Tree::from_leaves(&[forged]).root(), t.root());
+        assert_eq!(Tree::from_leaf_hashes(t.leaves().to_vec()).root(), t.root());
+    }
+}
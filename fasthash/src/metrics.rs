@@ -0,0 +1,351 @@
+//! Counters of the calls, input bytes and input sizes of every hash family.
+//!
+//! With the `metrics` feature, every call of a one-shot hash function of a byte
+//! array, such as `FastHash::hash`, `xx::hash_array` or `wy::hash_u64`, is counted
+//! once for its family, including the calls that the buffered hashers make from
+//! `finish` and the vectored calls over all of their buffers. Streaming hashers
+//! with a state of their own, such as `xx::Hasher64` or `crc32c::Hasher32`,
+//! are not counted.
+//!
+//! Each thread counts in counters of its own, with plain loads and stores,
+//! and `snapshot` adds up the counters of all threads, including those that
+//! have exited. Without the feature, nothing is counted and nothing is compiled
+//! into the hash functions.
+//!
+//! # Example
+//!
+//! ```
+//! use fasthash::{metrics, sea, FastHash};
+//!
+//! sea::Hash64::hash(b"hello world");
+//!
+//! let snapshot = metrics::snapshot();
+//! let sea = snapshot.get("sea::Hash64").unwrap();
+//!
+//! assert!(sea.calls >= 1);
+//! assert!(sea.bytes >= 11);
+//!
+//! // the Prometheus text exposition format
+//! print!("{}", snapshot.to_prometheus());
+//! ```
+use std::fmt::Write;
+use std::mem;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+
+/// The upper bounds of the input size buckets, in bytes, but the last.
+pub const SIZE_BOUNDS: [u64; 17] = [
+    1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768, 65536,
+];
+
+/// The number of input size buckets, the last one without an upper bound.
+pub const SIZE_BUCKETS: usize = SIZE_BOUNDS.len() + 1;
+
+// more than the hash families in the crate
+const MAX_FAMILIES: usize = 128;
+
+/// The counts of one hash family.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct FamilyMetrics {
+    /// The path of the family, such as `xx::Hash64`.
+    pub name: &'static str,
+    /// The number of calls.
+    pub calls: u64,
+    /// The number of bytes hashed.
+    pub bytes: u64,
+    /// The number of calls per input size bucket, see `SIZE_BOUNDS`.
+    pub sizes: [u64; SIZE_BUCKETS],
+}
+
+impl FamilyMetrics {
+    fn new(name: &'static str) -> Self {
+        FamilyMetrics {
+            name,
+            calls: 0,
+            bytes: 0,
+            sizes: [0; SIZE_BUCKETS],
+        }
+    }
+
+    fn add(&mut self, counters: &Counters) {
+        self.calls += counters.calls.load(Ordering::Relaxed);
+        self.bytes += counters.bytes.load(Ordering::Relaxed);
+
+        for (n, c) in self.sizes.iter_mut().zip(&counters.sizes) {
+            *n += c.load(Ordering::Relaxed);
+        }
+    }
+}
+
+/// The counts of every hash family that has been called.
+#[derive(Clone, Debug, Default)]
+pub struct Snapshot {
+    /// The families, in the order of their first call.
+    pub families: Vec<FamilyMetrics>,
+}
+
+impl Snapshot {
+    /// Returns the counts of a family by its path, such as `xx::Hash64`.
+    pub fn get(&self, name: &str) -> Option<&FamilyMetrics> {
+        self.families.iter().find(|family| family.name == name)
+    }
+
+    /// Formats the counts as a Prometheus histogram of the input sizes per family,
+    /// whose `_count` is the number of calls and `_sum` the number of bytes.
+    pub fn to_prometheus(&self) -> String {
+        let mut s = String::new();
+
+        s.push_str("# HELP fasthash_input_bytes The input sizes of the hash function calls.\n");
+        s.push_str("# TYPE fasthash_input_bytes histogram\n");
+
+        for family in &self.families {
+            let mut calls = 0;
+
+            for (n, bound) in family.sizes.iter().zip(&SIZE_BOUNDS) {
+                calls += n;
+
+                let _ = writeln!(
+                    s,
+                    "fasthash_input_bytes_bucket{{family=\"{}\",le=\"{}\"}} {}",
+                    family.name, bound, calls
+                );
+            }
+
+            let _ = writeln!(
+                s,
+                "fasthash_input_bytes_bucket{{family=\"{}\",le=\"+Inf\"}} {}",
+                family.name, family.calls
+            );
+            let _ = writeln!(
+                s,
+                "fasthash_input_bytes_sum{{family=\"{}\"}} {}",
+                family.name, family.bytes
+            );
+            let _ = writeln!(
+                s,
+                "fasthash_input_bytes_count{{family=\"{}\"}} {}",
+                family.name, family.calls
+            );
+        }
+
+        s
+    }
+}
+
+/// Returns the counts of all threads.
+///
+/// The counts of the threads that are hashing meanwhile may be a few calls apart.
+pub fn snapshot() -> Snapshot {
+    let registry = REGISTRY.lock().unwrap();
+    let mut families = registry.retired.clone();
+
+    for block in &registry.threads {
+        for (family, counters) in families.iter_mut().zip(block.iter()) {
+            family.add(counters);
+        }
+    }
+
+    Snapshot { families }
+}
+
+#[derive(Default)]
+struct Counters {
+    calls: AtomicU64,
+    bytes: AtomicU64,
+    sizes: [AtomicU64; SIZE_BUCKETS],
+}
+
+/// The counters of one thread, only written by that thread.
+type Block = [Counters; MAX_FAMILIES];
+
+struct Registry {
+    // the counts of the exited threads, and the names of the families
+    retired: Vec<FamilyMetrics>,
+    threads: Vec<Arc<Block>>,
+}
+
+lazy_static! {
+    static ref REGISTRY: Mutex<Registry> = Mutex::new(Registry {
+        retired: Vec::new(),
+        threads: Vec::new(),
+    });
+}
+
+/// Registers the counters of a thread, and retires them when it exits.
+struct Local(Arc<Block>);
+
+impl Local {
+    fn new() -> Self {
+        let block = Arc::new(unsafe {
+            // all zeros is a valid `AtomicU64`
+            mem::zeroed::<Block>()
+        });
+
+        REGISTRY.lock().unwrap().threads.push(block.clone());
+
+        Local(block)
+    }
+}
+
+impl Drop for Local {
+    fn drop(&mut self) {
+        let mut registry = REGISTRY.lock().unwrap();
+
+        for (family, counters) in registry.retired.iter_mut().zip(self.0.iter()) {
+            family.add(counters);
+        }
+
+        registry
+            .threads
+            .retain(|block| !Arc::ptr_eq(block, &self.0));
+    }
+}
+
+thread_local!(static LOCAL: Local = Local::new());
+
+#[inline(always)]
+fn bump(counter: &AtomicU64, n: u64) {
+    // only the owning thread writes, so this needs no atomic read-modify-write
+    counter.store(
+        counter.load(Ordering::Relaxed).wrapping_add(n),
+        Ordering::Relaxed,
+    );
+}
+
+/// Returns the input size bucket of `len` bytes.
+#[inline(always)]
+fn bucket(len: usize) -> usize {
+    let bits = (mem::size_of::<usize>() * 8) as u32 - len.saturating_sub(1).leading_zeros();
+
+    (bits as usize).min(SIZE_BUCKETS - 1)
+}
+
+/// The counters of one hash family, registered on its first call.
+#[doc(hidden)]
+pub struct Family {
+    // one more than the index of the family, or zero before its first call
+    id: AtomicUsize,
+}
+
+impl Family {
+    #[doc(hidden)]
+    pub const fn new() -> Self {
+        Family {
+            id: AtomicUsize::new(0),
+        }
+    }
+
+    #[doc(hidden)]
+    #[inline(always)]
+    pub fn record(&self, type_name: fn() -> &'static str, len: usize) {
+        let mut id = self.id.load(Ordering::Relaxed);
+
+        if id == 0 {
+            id = self.register(type_name());
+        }
+
+        // the counters of the thread are gone while it exits
+        let _ = LOCAL.try_with(|local| {
+            let counters = &local.0[id - 1];
+
+            bump(&counters.calls, 1);
+            bump(&counters.bytes, len as u64);
+            bump(&counters.sizes[bucket(len)], 1);
+        });
+    }
+
+    #[cold]
+    fn register(&self, type_name: &'static str) -> usize {
+        let mut registry = REGISTRY.lock().unwrap();
+        let id = self.id.load(Ordering::Relaxed);
+
+        if id != 0 {
+            return id;
+        }
+
+        assert!(registry.retired.len() < MAX_FAMILIES);
+
+        let name = type_name.trim_start_matches("fasthash::");
+
+        registry.retired.push(FamilyMetrics::new(name));
+
+        let id = registry.retired.len();
+
+        self.id.store(id, Ordering::Relaxed);
+
+        id
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::io::IoSlice;
+    use std::thread;
+
+    use super::*;
+    use crate::{crc32c, sea, wy, xx, FastHash};
+
+    #[test]
+    fn test_bucket() {
+        assert_eq!(bucket(0), 0);
+        assert_eq!(bucket(1), 0);
+        assert_eq!(bucket(2), 1);
+        assert_eq!(bucket(3), 2);
+        assert_eq!(bucket(4), 2);
+        assert_eq!(bucket(65536), 16);
+        assert_eq!(bucket(65537), 17);
+        assert_eq!(bucket(usize::max_value()), 17);
+    }
+
+    #[test]
+    fn test_snapshot() {
+        let before = snapshot()
+            .get("sea::Hash64")
+            .cloned()
+            .unwrap_or_else(|| FamilyMetrics::new("sea::Hash64"));
+
+        sea::Hash64::hash(b"hello");
+        thread::spawn(|| sea::Hash64::hash(&[0; 100][..]))
+            .join()
+            .unwrap();
+
+        let snapshot = snapshot();
+        let after = snapshot.get("sea::Hash64").unwrap();
+
+        assert!(after.calls >= before.calls + 2);
+        assert!(after.bytes >= before.bytes + 105);
+        assert!(after.sizes[3] > before.sizes[3]);
+        assert!(after.sizes[7] > before.sizes[7]);
+        assert!(snapshot
+            .to_prometheus()
+            .contains("fasthash_input_bytes_bucket{family=\"sea::Hash64\",le=\"+Inf\"}"));
+    }
+
+    #[test]
+    fn test_entry_points() {
+        let get = |name| {
+            snapshot()
+                .get(name)
+                .cloned()
+                .unwrap_or_else(|| FamilyMetrics::new(name))
+        };
+        let (wy_before, xx_before, crc_before) =
+            (get("wy::Hash64"), get("xx::Hash64"), get("crc32c::Hash32"));
+
+        wy::hash_u64(123, 0);
+        xx::hash_array(&[0; 16]);
+
+        // one call over all of the buffers
+        let data = [0_u8; 3000];
+        let bufs = data.chunks(1000).map(IoSlice::new).collect::<Vec<_>>();
+
+        crc32c::Hash32::hash_vectored(&bufs);
+
+        let (wy_after, xx_after, crc_after) =
+            (get("wy::Hash64"), get("xx::Hash64"), get("crc32c::Hash32"));
+
+        assert!(wy_after.sizes[3] > wy_before.sizes[3]);
+        assert!(xx_after.sizes[4] > xx_before.sizes[4]);
+        assert!(crc_after.sizes[12] > crc_before.sizes[12]);
+    }
+}
@@ -41,6 +41,8 @@
 //!
 #![allow(non_camel_case_types)]
 
+use std::os::raw::c_void;
+
 use crate::ffi;
 
 use crate::hasher::FastHash;
@@ -65,6 +67,8 @@ impl FastHash for Hash64_1 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         let mut hash = 0_u64;
 
         unsafe {
@@ -119,6 +123,8 @@ impl FastHash for Hash64_2 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         let mut hash = 0_u64;
 
         unsafe {
@@ -182,6 +188,8 @@ impl FastHash for Hash128_1 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         let mut hash = 0;
 
         unsafe {
@@ -245,6 +253,8 @@ impl FastHash for Hash128_2 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         let mut hash = 0;
 
         unsafe {
@@ -307,6 +317,8 @@ pub mod crc {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u64 {
+            record_hash!(bytes.as_ref().len());
+
             let mut hash = 0_u64;
 
             unsafe {
@@ -364,6 +376,8 @@ pub mod crc {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u64 {
+            record_hash!(bytes.as_ref().len());
+
             let mut hash = 0_u64;
 
             unsafe {
@@ -427,6 +441,8 @@ pub mod crc {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u128 {
+            record_hash!(bytes.as_ref().len());
+
             let mut hash = 0;
 
             unsafe {
@@ -490,6 +506,8 @@ pub mod crc {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u128 {
+            record_hash!(bytes.as_ref().len());
+
             let mut hash = 0;
 
             unsafe {
@@ -580,3 +598,99 @@ cfg_if! {
         }
     }
 }
+
+/// `MetroHash` 64-bit hash function for a fixed-length array, with `Hash64_1`.
+///
+/// The software variant is used even where `hash64` uses the HW CRC instruction.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `Hash64_1`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{metro, FastHash};
+///
+/// let key = [7_u8; 12];
+///
+/// assert_eq!(metro::hash_array(&key), metro::Hash64_1::hash(&key));
+/// ```
+#[inline(always)]
+pub fn hash_array<const N: usize>(v: &[u8; N]) -> u64 {
+    hash_array_with_seed(v, 0)
+}
+
+/// `MetroHash` 64-bit hash function for a fixed-length array, with `Hash64_1`.
+/// For convenience, a 32-bit seed is also hashed into the result.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `Hash64_1`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{metro, FastHash};
+///
+/// let key = [7_u8; 24];
+///
+/// assert_eq!(metro::hash_array_with_seed(&key, 123), metro::Hash64_1::hash_with_seed(&key, 123));
+/// ```
+#[inline(always)]
+pub fn hash_array_with_seed<const N: usize>(v: &[u8; N], seed: u32) -> u64 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::metrohash64_1_fixed4(p, seed),
+            8 => ffi::metrohash64_1_fixed8(p, seed),
+            12 => ffi::metrohash64_1_fixed12(p, seed),
+            16 => ffi::metrohash64_1_fixed16(p, seed),
+            20 => ffi::metrohash64_1_fixed20(p, seed),
+            24 => ffi::metrohash64_1_fixed24(p, seed),
+            32 => ffi::metrohash64_1_fixed32(p, seed),
+            64 => ffi::metrohash64_1_fixed64(p, seed),
+            _ => return Hash64_1::hash_with_seed(&v[..], seed),
+        }
+    };
+
+    record_hash!(Hash64_1, N);
+
+    h
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn check_hash_array<const N: usize>() {
+        let mut key = [0_u8; N];
+
+        for (i, b) in key.iter_mut().enumerate() {
+            *b = (i * 31) as u8;
+        }
+
+        assert_eq!(hash_array(&key), Hash64_1::hash(&key[..]), "N = {}", N);
+        assert_eq!(
+            hash_array_with_seed(&key, 42),
+            Hash64_1::hash_with_seed(&key[..], 42),
+            "N = {}",
+            N
+        );
+    }
+
+    #[test]
+    fn test_hash_array_matches_slice() {
+        check_hash_array::<4>();
+        check_hash_array::<8>();
+        check_hash_array::<12>();
+        check_hash_array::<16>();
+        check_hash_array::<20>();
+        check_hash_array::<24>();
+        check_hash_array::<32>();
+        check_hash_array::<64>();
+        check_hash_array::<7>();
+    }
+}
@@ -0,0 +1,473 @@
+//! `MinHash` signatures for estimating Jaccard similarity between sets.
+//!
+//! by Andrei Z. Broder
+//!
+//! https://en.wikipedia.org/wiki/MinHash
+//!
+//! Each element is hashed **once** with the underlying `FastHash` family,
+//! and the `k` permutations are derived from that base hash with a cheap
+//! multiply-add-xorshift mixer, instead of running `k` full hash functions.
+//! The per-permutation update is a straight-line loop over flat arrays,
+//! which the compiler turns into SIMD multiply and min-reduction.
+//!
+//! Signatures can be compressed to `b`-bit `MinHash` (Li & König)
+//! and split into LSH bands for candidate-pair lookup.
+//!
+//! # Example
+//!
+//! ```
+//! use fasthash::{minhash::MinHash, xxh3};
+//!
+//! let mut a = MinHash::<xxh3::Hash64>::new(128);
+//! let mut b = MinHash::<xxh3::Hash64>::new(128);
+//!
+//! a.extend(&["the", "quick", "brown", "fox", "jumps"]);
+//! b.extend(&["the", "quick", "brown", "fox", "sleeps"]);
+//!
+//! let j = a.jaccard(&b);
+//!
+//! assert!(j > 0.3 && j < 1.0);
+//! assert_eq!(a.jaccard(&a), 1.0);
+//! ```
+//!
+use std::marker::PhantomData;
+
+use num_traits::AsPrimitive;
+
+use crate::hasher::FastHash;
+
+/// The default seed used to derive the permutation coefficients.
+pub const DEFAULT_SEED: u64 = 0x9E37_79B9_7F4A_7C15;
+
+/// Number of permutations processed per inner loop.
+///
+/// Chosen so that one block of `mins`, `mul` and `add` fits in
+/// a handful of AVX-512 registers.
+const LANES: usize = 8;
+
+#[inline(always)]
+fn splitmix64(state: &mut u64) -> u64 {
+    *state = state.wrapping_add(0x9E37_79B9_7F4A_7C15);
+
+    let mut z = *state;
+    z = (z ^ (z >> 30)).wrapping_mul(0xBF58_476D_1CE4_E5B9);
+    z = (z ^ (z >> 27)).wrapping_mul(0x94D0_49BB_1331_11EB);
+    z ^ (z >> 31)
+}
+
+#[inline(always)]
+fn permute(h: u64, mul: u64, add: u64) -> u64 {
+    let x = h.wrapping_mul(mul).wrapping_add(add);
+
+    x ^ (x >> 32)
+}
+
+/// A `MinHash` signature builder with `k` permutations.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{minhash::MinHash, murmur3};
+///
+/// let mut m = MinHash::<murmur3::Hash32>::new(64);
+///
+/// m.insert("hello");
+/// m.insert("world");
+///
+/// assert_eq!(m.k(), 64);
+/// assert!(!m.is_empty());
+/// ```
+#[derive(Clone, Debug)]
+pub struct MinHash<H: FastHash> {
+    seed: u64,
+    mins: Vec<u64>,
+    mul: Vec<u64>,
+    add: Vec<u64>,
+    phantom: PhantomData<H>,
+}
+
+impl<H> MinHash<H>
+where
+    H: FastHash,
+    H::Hash: AsPrimitive<u64>,
+{
+    /// Constructs a new `MinHash` with `k` permutations and the default seed.
+    #[inline(always)]
+    pub fn new(k: usize) -> Self {
+        Self::with_seed(k, DEFAULT_SEED)
+    }
+
+    /// Constructs a new `MinHash` with `k` permutations derived from `seed`.
+    ///
+    /// Signatures are only comparable if they were built with
+    /// the same hash family, `k` and seed.
+    pub fn with_seed(k: usize, seed: u64) -> Self {
+        let mut state = seed;
+        let mut mul = Vec::with_capacity(k);
+        let mut add = Vec::with_capacity(k);
+
+        for _ in 0..k {
+            mul.push(splitmix64(&mut state) | 1);
+            add.push(splitmix64(&mut state));
+        }
+
+        MinHash {
+            seed,
+            mins: vec![u64::max_value(); k],
+            mul,
+            add,
+            phantom: PhantomData,
+        }
+    }
+
+    /// Returns `k`, the number of permutations.
+    #[inline(always)]
+    pub fn k(&self) -> usize {
+        self.mins.len()
+    }
+
+    /// Returns `true` if no element has been inserted.
+    #[inline(always)]
+    pub fn is_empty(&self) -> bool {
+        self.mins.iter().all(|&m| m == u64::max_value())
+    }
+
+    /// Returns the seed used to derive the permutations.
+    #[inline(always)]
+    pub fn seed(&self) -> u64 {
+        self.seed
+    }
+
+    /// Extracts the signature, one minimum per permutation.
+    #[inline(always)]
+    pub fn signature(&self) -> &[u64] {
+        &self.mins
+    }
+
+    /// Resets the signature to the empty set.
+    pub fn clear(&mut self) {
+        for m in &mut self.mins {
+            *m = u64::max_value();
+        }
+    }
+
+    /// Inserts a shingle into the set.
+    #[inline(always)]
+    pub fn insert<T: AsRef<[u8]>>(&mut self, shingle: T) {
+        self.insert_hash(H::hash(shingle).as_())
+    }
+
+    /// Inserts an already hashed shingle into the set.
+    pub fn insert_hash(&mut self, h: u64) {
+        let mut mins = self.mins.chunks_exact_mut(LANES);
+        let mut mul = self.mul.chunks_exact(LANES);
+        let mut add = self.add.chunks_exact(LANES);
+
+        for ((m, a), b) in (&mut mins).zip(&mut mul).zip(&mut add) {
+            for i in 0..LANES {
+                let v = permute(h, a[i], b[i]);
+
+                m[i] = if v < m[i] { v } else { m[i] };
+            }
+        }
+
+        for ((m, &a), &b) in mins
+            .into_remainder()
+            .iter_mut()
+            .zip(mul.remainder())
+            .zip(add.remainder())
+        {
+            let v = permute(h, a, b);
+
+            if v < *m {
+                *m = v;
+            }
+        }
+    }
+
+    /// Merges another signature into this one, producing the signature of the union.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the two signatures were built with different `k` or seed.
+    pub fn merge(&mut self, other: &Self) {
+        assert_eq!(self.k(), other.k(), "signature length mismatch");
+        assert_eq!(self.seed, other.seed, "signature seed mismatch");
+
+        for (m, &o) in self.mins.iter_mut().zip(&other.mins) {
+            *m = if o < *m { o } else { *m };
+        }
+    }
+
+    /// Estimates the Jaccard similarity between the two sets.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the two signatures were built with different `k` or seed.
+    pub fn jaccard(&self, other: &Self) -> f64 {
+        assert_eq!(self.k(), other.k(), "signature length mismatch");
+        assert_eq!(self.seed, other.seed, "signature seed mismatch");
+
+        if self.mins.is_empty() {
+            return 0.0;
+        }
+
+        let same = self
+            .mins
+            .iter()
+            .zip(&other.mins)
+            .filter(|&(a, b)| a == b)
+            .count();
+
+        same as f64 / self.k() as f64
+    }
+
+    /// Compresses the signature to `b` bits per permutation.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `b` is not in `1..=64`.
+    pub fn to_bbit(&self, b: u32) -> BBitMinHash {
+        BBitMinHash::new(&self.mins, b, self.seed)
+    }
+
+    /// Splits the signature into LSH bands of `rows` permutations each,
+    /// and hashes every band into a bucket key.
+    ///
+    /// Two sets whose signatures agree on all rows of any band
+    /// share that band's key, so keys can be indexed per band
+    /// to find candidate pairs. A trailing partial band is ignored.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `rows` is zero.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use fasthash::{minhash::MinHash, xxh3};
+    ///
+    /// let mut m = MinHash::<xxh3::Hash64>::new(128);
+    ///
+    /// m.extend(&["a", "b", "c"]);
+    ///
+    /// assert_eq!(m.bands(4).len(), 32);
+    /// assert_eq!(m.bands(4), m.clone().bands(4));
+    /// ```
+    pub fn bands(&self, rows: usize) -> Vec<u64> {
+        assert!(rows > 0, "band must have at least one row");
+
+        let mut buf = Vec::with_capacity(rows * 8);
+
+        self.mins
+            .chunks_exact(rows)
+            .map(|band| {
+                buf.clear();
+
+                for m in band {
+                    buf.extend_from_slice(&m.to_le_bytes());
+                }
+
+                H::hash(&buf).as_()
+            })
+            .collect()
+    }
+}
+
+impl<H, T> Extend<T> for MinHash<H>
+where
+    H: FastHash,
+    H::Hash: AsPrimitive<u64>,
+    T: AsRef<[u8]>,
+{
+    fn extend<I: IntoIterator<Item = T>>(&mut self, iter: I) {
+        for shingle in iter {
+            self.insert(shingle)
+        }
+    }
+}
+
+/// A `b`-bit `MinHash` signature, keeping only the lowest `b` bits of each minimum.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{minhash::MinHash, xxh3};
+///
+/// let mut a = MinHash::<xxh3::Hash64>::new(256);
+/// let mut b = MinHash::<xxh3::Hash64>::new(256);
+///
+/// a.extend((0..100).map(|i: u32| i.to_le_bytes()));
+/// b.extend((50..150).map(|i: u32| i.to_le_bytes()));
+///
+/// let (a, b) = (a.to_bbit(2), b.to_bbit(2));
+///
+/// assert_eq!(a.len(), 256);
+/// assert!(a.jaccard(&b) < 0.7);
+/// assert_eq!(a.jaccard(&a), 1.0);
+/// ```
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct BBitMinHash {
+    bits: u32,
+    len: usize,
+    seed: u64,
+    words: Vec<u64>,
+}
+
+impl BBitMinHash {
+    fn new(mins: &[u64], bits: u32, seed: u64) -> Self {
+        assert!(bits > 0 && bits <= 64, "b must be in 1..=64");
+
+        let per_word = (64 / bits) as usize;
+        let mask = if bits == 64 {
+            u64::max_value()
+        } else {
+            (1 << bits) - 1
+        };
+
+        let words = mins
+            .chunks(per_word)
+            .map(|chunk| {
+                chunk
+                    .iter()
+                    .enumerate()
+                    .fold(0, |w, (i, &m)| w | ((m & mask) << (i as u32 * bits)))
+            })
+            .collect();
+
+        BBitMinHash {
+            bits,
+            len: mins.len(),
+            seed,
+            words,
+        }
+    }
+
+    /// Returns the number of bits kept per permutation.
+    #[inline(always)]
+    pub fn bits(&self) -> u32 {
+        self.bits
+    }
+
+    /// Returns the number of permutations.
+    #[inline(always)]
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Returns `true` if the signature has no permutation.
+    #[inline(always)]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Extracts the packed signature words.
+    #[inline(always)]
+    pub fn as_words(&self) -> &[u64] {
+        &self.words
+    }
+
+    /// Counts the permutations whose `b`-bit values match.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the two signatures differ in `b`, `k` or seed.
+    pub fn matches(&self, other: &Self) -> usize {
+        assert_eq!(self.bits, other.bits, "b-bit width mismatch");
+        assert_eq!(self.len, other.len, "signature length mismatch");
+        assert_eq!(self.seed, other.seed, "signature seed mismatch");
+
+        let bits = self.bits;
+        let per_word = (64 / bits) as usize;
+        let mask = if bits == 64 {
+            u64::max_value()
+        } else {
+            (1 << bits) - 1
+        };
+
+        self.words
+            .iter()
+            .zip(&other.words)
+            .enumerate()
+            .map(|(n, (&a, &b))| {
+                let x = a ^ b;
+                let slots = per_word.min(self.len - n * per_word);
+
+                (0..slots)
+                    .filter(|&i| (x >> (i as u32 * bits)) & mask == 0)
+                    .count()
+            })
+            .sum()
+    }
+
+    /// Estimates the Jaccard similarity, correcting for random `b`-bit collisions.
+    ///
+    /// Uses the large-set approximation where two unrelated minima
+    /// agree on their lowest `b` bits with probability `2^-b`.
+    pub fn jaccard(&self, other: &Self) -> f64 {
+        if self.len == 0 {
+            return 0.0;
+        }
+
+        let p = self.matches(other) as f64 / self.len as f64;
+        let c = 0.5_f64.powi(self.bits.min(63) as i32);
+
+        ((p - c) / (1.0 - c)).max(0.0)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::xxh3;
+
+    #[test]
+    fn test_minhash_jaccard() {
+        let mut a = MinHash::<xxh3::Hash64>::new(256);
+        let mut b = MinHash::<xxh3::Hash64>::new(256);
+
+        a.extend((0..1000_u32).map(|i| i.to_le_bytes()));
+        b.extend((500..1500_u32).map(|i| i.to_le_bytes()));
+
+        // |A ∩ B| / |A ∪ B| = 500 / 1500
+        let j = a.jaccard(&b);
+
+        assert!((j - 1.0 / 3.0).abs() < 0.1, "jaccard = {}", j);
+
+        let j = a.to_bbit(4).jaccard(&b.to_bbit(4));
+
+        assert!((j - 1.0 / 3.0).abs() < 0.15, "b-bit jaccard = {}", j);
+    }
+
+    #[test]
+    fn test_minhash_merge() {
+        let mut a = MinHash::<xxh3::Hash64>::new(100);
+        let mut b = MinHash::<xxh3::Hash64>::new(100);
+        let mut c = MinHash::<xxh3::Hash64>::new(100);
+
+        a.extend(&["a", "b"]);
+        b.extend(&["c", "d"]);
+        c.extend(&["a", "b", "c", "d"]);
+
+        a.merge(&b);
+
+        assert_eq!(a.signature(), c.signature());
+    }
+
+    #[test]
+    fn test_bbit_packing() {
+        let mut m = MinHash::<xxh3::Hash64>::new(70);
+
+        m.insert("hello");
+
+        for &b in &[1, 3, 7, 8, 64] {
+            let s = m.to_bbit(b);
+
+            assert_eq!(s.matches(&s), 70);
+            assert_eq!(
+                s.as_words().len(),
+                (70 + (64 / b as usize) - 1) / (64 / b as usize)
+            );
+        }
+    }
+}
@@ -0,0 +1,302 @@
+//! Order-independent, incrementally updatable digests of sets and multisets.
+//!
+//! by Mihir Bellare and Daniele Micciancio (`AdHash`)
+//!
+//! https://cseweb.ucsd.edu/~mihir/papers/inchash.pdf
+//!
+//! Every element is hashed with a 128-bit `FastHash` family, passed through
+//! a bijective 128-bit mixer, and added into an accumulator modulo `2^128`.
+//! Because addition is commutative and invertible, the digest does not depend
+//! on the insertion order, elements can be removed by subtraction, and
+//! partial digests computed by parallel workers can be merged by addition.
+//!
+//! The digest counts multiplicities; a collection without duplicates
+//! is simply a multiset where every element appears once.
+//!
+//! # Example
+//!
+//! ```
+//! use fasthash::{multiset::MultisetHash, xxh3};
+//!
+//! let a: MultisetHash<xxh3::Hash128> = ["x", "y", "z"].iter().collect();
+//! let b: MultisetHash<xxh3::Hash128> = ["z", "x", "y"].iter().collect();
+//!
+//! assert_eq!(a.digest(), b.digest());
+//! ```
+//!
+use std::iter::FromIterator;
+use std::marker::PhantomData;
+
+use crate::hasher::FastHash;
+
+/// Bijective 128-bit finalizer applied to every element hash before it is added,
+/// so structured hash outputs do not add up linearly.
+#[inline(always)]
+fn mix(h: u128) -> u128 {
+    const K0: u128 = 0x9E37_79B9_7F4A_7C15_F39C_C060_5CED_C835;
+    const K1: u128 = 0xC2B2_AE3D_27D4_EB4F_1656_67B1_9E37_79F9;
+
+    let mut x = h;
+
+    x ^= x >> 67;
+    x = x.wrapping_mul(K0 | 1);
+    x ^= x >> 61;
+    x = x.wrapping_mul(K1 | 1);
+    x ^ (x >> 64)
+}
+
+/// An order-independent digest of a multiset.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{city, multiset::MultisetHash};
+///
+/// let mut left = MultisetHash::<city::Hash128>::new();
+/// let mut right = MultisetHash::<city::Hash128>::new();
+///
+/// // two workers hash disjoint partitions
+/// left.extend(&["alice", "bob"]);
+/// right.extend(&["carol"]);
+/// left.merge(&right);
+///
+/// let mut all: MultisetHash<city::Hash128> = ["carol", "alice", "bob", "dave"].iter().collect();
+///
+/// all.remove("dave");
+///
+/// assert_eq!(left.digest(), all.digest());
+/// assert_eq!(left.len(), 3);
+/// ```
+pub struct MultisetHash<H: FastHash<Hash = u128>> {
+    seed: H::Seed,
+    sum: u128,
+    count: u64,
+    phantom: PhantomData<H>,
+}
+
+impl<H: FastHash<Hash = u128>> Clone for MultisetHash<H> {
+    fn clone(&self) -> Self {
+        MultisetHash {
+            seed: self.seed,
+            sum: self.sum,
+            count: self.count,
+            phantom: PhantomData,
+        }
+    }
+}
+
+impl<H: FastHash<Hash = u128>> Default for MultisetHash<H> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<H: FastHash<Hash = u128>> MultisetHash<H> {
+    /// Constructs an empty digest.
+    #[inline(always)]
+    pub fn new() -> Self {
+        Self::with_seed(Default::default())
+    }
+
+    /// Constructs an empty digest whose elements are hashed with `seed`.
+    ///
+    /// Digests are only comparable if they were built with the same seed.
+    #[inline(always)]
+    pub fn with_seed(seed: H::Seed) -> Self {
+        MultisetHash {
+            seed,
+            sum: 0,
+            count: 0,
+            phantom: PhantomData,
+        }
+    }
+
+    /// Returns the number of elements, counting multiplicities.
+    #[inline(always)]
+    pub fn len(&self) -> u64 {
+        self.count
+    }
+
+    /// Returns `true` if the multiset is empty.
+    #[inline(always)]
+    pub fn is_empty(&self) -> bool {
+        self.count == 0
+    }
+
+    #[inline(always)]
+    fn element(&self, elem: &[u8]) -> u128 {
+        mix(H::hash_with_seed(elem, self.seed))
+    }
+
+    /// Adds one occurrence of an element.
+    #[inline(always)]
+    pub fn insert<T: AsRef<[u8]>>(&mut self, elem: T) {
+        let h = self.element(elem.as_ref());
+
+        self.sum = self.sum.wrapping_add(h);
+        self.count = self.count.wrapping_add(1);
+    }
+
+    /// Removes one occurrence of an element.
+    ///
+    /// Removing an element that was never inserted leaves a digest
+    /// that will not match any real collection.
+    #[inline(always)]
+    pub fn remove<T: AsRef<[u8]>>(&mut self, elem: T) {
+        let h = self.element(elem.as_ref());
+
+        self.sum = self.sum.wrapping_sub(h);
+        self.count = self.count.wrapping_sub(1);
+    }
+
+    /// Replaces one occurrence of `old` with `new`.
+    #[inline(always)]
+    pub fn replace<T: AsRef<[u8]>, U: AsRef<[u8]>>(&mut self, old: T, new: U) {
+        let h = self
+            .element(new.as_ref())
+            .wrapping_sub(self.element(old.as_ref()));
+
+        self.sum = self.sum.wrapping_add(h);
+    }
+
+    /// Adds all elements of another digest, producing the digest of the multiset union.
+    #[inline(always)]
+    pub fn merge(&mut self, other: &Self) {
+        self.sum = self.sum.wrapping_add(other.sum);
+        self.count = self.count.wrapping_add(other.count);
+    }
+
+    /// Removes all elements of another digest, producing the digest of the multiset difference.
+    #[inline(always)]
+    pub fn subtract(&mut self, other: &Self) {
+        self.sum = self.sum.wrapping_sub(other.sum);
+        self.count = self.count.wrapping_sub(other.count);
+    }
+
+    /// Resets to the empty multiset.
+    #[inline(always)]
+    pub fn clear(&mut self) {
+        self.sum = 0;
+        self.count = 0;
+    }
+
+    /// Returns the raw accumulator and element count,
+    /// which can be shipped to another worker and merged back with `from_parts`.
+    #[inline(always)]
+    pub fn into_parts(self) -> (u128, u64) {
+        (self.sum, self.count)
+    }
+
+    /// Restores a digest from its raw accumulator and element count.
+    #[inline(always)]
+    pub fn from_parts(seed: H::Seed, sum: u128, count: u64) -> Self {
+        MultisetHash {
+            seed,
+            sum,
+            count,
+            phantom: PhantomData,
+        }
+    }
+
+    /// Returns the final digest, binding the accumulator to the element count.
+    pub fn digest(&self) -> u128 {
+        let mut buf = [0_u8; 24];
+
+        buf[..16].copy_from_slice(&self.sum.to_le_bytes());
+        buf[16..].copy_from_slice(&self.count.to_le_bytes());
+
+        H::hash_with_seed(&buf[..], self.seed)
+    }
+}
+
+impl<H, T> Extend<T> for MultisetHash<H>
+where
+    H: FastHash<Hash = u128>,
+    T: AsRef<[u8]>,
+{
+    fn extend<I: IntoIterator<Item = T>>(&mut self, iter: I) {
+        for elem in iter {
+            self.insert(elem)
+        }
+    }
+}
+
+impl<H, T> FromIterator<T> for MultisetHash<H>
+where
+    H: FastHash<Hash = u128>,
+    T: AsRef<[u8]>,
+{
+    fn from_iter<I: IntoIterator<Item = T>>(iter: I) -> Self {
+        let mut h = Self::new();
+
+        h.extend(iter);
+        h
+    }
+}
+
+impl<H: FastHash<Hash = u128>> PartialEq for MultisetHash<H> {
+    fn eq(&self, other: &Self) -> bool {
+        self.sum == other.sum && self.count == other.count
+    }
+}
+
+impl<H: FastHash<Hash = u128>> Eq for MultisetHash<H> {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::xxh3;
+
+    type Digest = MultisetHash<xxh3::Hash128>;
+
+    #[test]
+    fn test_order_independent() {
+        let rows = (0..1000_u32).map(|i| i.to_le_bytes()).collect::<Vec<_>>();
+        let a = Digest::from_iter(&rows);
+        let b = Digest::from_iter(rows.iter().rev());
+
+        assert!(a == b);
+        assert_eq!(a.digest(), b.digest());
+        assert_ne!(a.digest(), Digest::from_iter(&rows[1..]).digest());
+    }
+
+    #[test]
+    fn test_multiplicity() {
+        let a = Digest::from_iter(&["x", "x", "y"]);
+        let b = Digest::from_iter(&["x", "y", "y"]);
+        let c = Digest::from_iter(&["x", "y"]);
+
+        assert!(a != b);
+        assert!(a != c);
+    }
+
+    #[test]
+    fn test_insert_remove_merge() {
+        let mut parts = (0..4)
+            .map(|n| Digest::from_iter((n * 100..(n + 1) * 100_u32).map(|i| i.to_le_bytes())))
+            .collect::<Vec<_>>();
+        let all = Digest::from_iter((0..400_u32).map(|i| i.to_le_bytes()));
+        let mut merged = parts.pop().unwrap();
+
+        for p in &parts {
+            merged.merge(p);
+        }
+
+        assert!(merged == all);
+
+        merged.subtract(&parts[0]);
+        merged.insert(1000_u32.to_le_bytes());
+        merged.remove(1000_u32.to_le_bytes());
+        merged.replace(150_u32.to_le_bytes(), 150_u32.to_le_bytes());
+
+        assert!(merged == Digest::from_iter((100..400_u32).map(|i| i.to_le_bytes())));
+        assert!(Digest::from_iter(&["a"]) != Digest::new());
+
+        let mut empty = Digest::from_iter(&["a"]);
+
+        empty.remove("a");
+
+        assert!(empty.is_empty());
+        assert_eq!(empty.digest(), Digest::new().digest());
+    }
+}
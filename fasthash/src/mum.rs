@@ -79,6 +79,8 @@ impl FastHash for Hash64 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::mum_hash_(
                 bytes.as_ref().as_ptr() as *const c_void,
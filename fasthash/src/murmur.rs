@@ -66,6 +66,8 @@ impl FastHash for Hash32 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHash1(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -115,6 +117,8 @@ impl FastHash for Hash32Aligned {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHash1Aligned(
                 bytes.as_ref().as_ptr() as *const c_void,
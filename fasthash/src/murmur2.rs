@@ -90,6 +90,8 @@ impl FastHash for Hash32 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHash2(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -139,6 +141,8 @@ impl FastHash for Hash32A {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHash2A(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -188,6 +192,8 @@ impl FastHash for Hash32Neutral {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHashNeutral2(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -237,6 +243,8 @@ impl FastHash for Hash32Aligned {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHashAligned2(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -289,6 +297,8 @@ impl FastHash for Hash64_x64 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHash64A(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -341,6 +351,8 @@ impl FastHash for Hash64_x86 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::MurmurHash64B(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -56,6 +56,8 @@ impl FastHash for Hash32 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             let mut hash = 0_u32;
 
@@ -119,6 +121,8 @@ impl FastHash for Hash128_x86 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             let mut hash = 0;
 
@@ -182,6 +186,8 @@ impl FastHash for Hash128_x64 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             let mut hash = 0;
 
@@ -229,6 +235,66 @@ pub fn hash32_with_seed<T: AsRef<[u8]>>(v: T, seed: u32) -> u32 {
     Hash32::hash_with_seed(v, seed)
 }
 
+/// `MurmurHash3` 32-bit hash function for a fixed-length array.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash32`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::murmur3;
+///
+/// let key = [7_u8; 12];
+///
+/// assert_eq!(murmur3::hash_array(&key), murmur3::hash32(&key));
+/// ```
+#[inline(always)]
+pub fn hash_array<const N: usize>(v: &[u8; N]) -> u32 {
+    hash_array_with_seed(v, 0)
+}
+
+/// `MurmurHash3` 32-bit hash function for a fixed-length array.
+/// For convenience, a 32-bit seed is also hashed into the result.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash32_with_seed`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::murmur3;
+///
+/// let key = [7_u8; 24];
+///
+/// assert_eq!(murmur3::hash_array_with_seed(&key, 123), murmur3::hash32_with_seed(&key, 123));
+/// ```
+#[inline(always)]
+pub fn hash_array_with_seed<const N: usize>(v: &[u8; N], seed: u32) -> u32 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::MurmurHash3_x86_32_fixed4(p, seed),
+            8 => ffi::MurmurHash3_x86_32_fixed8(p, seed),
+            12 => ffi::MurmurHash3_x86_32_fixed12(p, seed),
+            16 => ffi::MurmurHash3_x86_32_fixed16(p, seed),
+            20 => ffi::MurmurHash3_x86_32_fixed20(p, seed),
+            24 => ffi::MurmurHash3_x86_32_fixed24(p, seed),
+            32 => ffi::MurmurHash3_x86_32_fixed32(p, seed),
+            64 => ffi::MurmurHash3_x86_32_fixed64(p, seed),
+            _ => return hash32_with_seed(&v[..], seed),
+        }
+    };
+
+    record_hash!(Hash32, N);
+
+    h
+}
+
 /// `MurmurHash3` 128-bit hash functions for a byte array.
 #[inline(always)]
 pub fn hash128<T: AsRef<[u8]>>(v: T) -> u128 {
@@ -249,3 +315,37 @@ pub fn hash128_with_seed<T: AsRef<[u8]>>(v: T, seed: u32) -> u128 {
         Hash128_x86::hash_with_seed(v, seed)
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn check_hash_array<const N: usize>() {
+        let mut key = [0_u8; N];
+
+        for (i, b) in key.iter_mut().enumerate() {
+            *b = (i * 31) as u8;
+        }
+
+        assert_eq!(hash_array(&key), hash32(&key[..]), "N = {}", N);
+        assert_eq!(
+            hash_array_with_seed(&key, 42),
+            hash32_with_seed(&key[..], 42),
+            "N = {}",
+            N
+        );
+    }
+
+    #[test]
+    fn test_hash_array_matches_slice() {
+        check_hash_array::<4>();
+        check_hash_array::<8>();
+        check_hash_array::<12>();
+        check_hash_array::<16>();
+        check_hash_array::<20>();
+        check_hash_array::<24>();
+        check_hash_array::<32>();
+        check_hash_array::<64>();
+        check_hash_array::<7>();
+    }
+}
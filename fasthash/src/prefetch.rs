@@ -0,0 +1,292 @@
+//! Hash keys in batches and prefetch their buckets ahead of the lookup.
+//!
+//! Probing a table much larger than the cache costs one DRAM miss per key,
+//! an order of magnitude more than hashing the key. `Prefetcher` hashes the
+//! keys a batch ahead of the caller, issues a software prefetch for the bucket
+//! each hash maps to, and yields the `(key, hash)` pairs in their original order,
+//! so the misses of a whole batch are in flight while the previous one is probed.
+//!
+//! The table layout is supplied by the caller as a function from a hash to the
+//! address of its bucket. The address is only prefetched, never dereferenced,
+//! so it may be computed with `wrapping_add` without a bounds check.
+//!
+//! # Example
+//!
+//! ```
+//! use fasthash::{city, prefetch::Prefetcher, FastHash};
+//!
+//! const MASK: usize = 1023;
+//!
+//! let mut buckets = vec![Vec::new(); MASK + 1];
+//!
+//! for key in &["hello", "world"] {
+//!     buckets[city::Hash64::hash(key) as usize & MASK].push(*key);
+//! }
+//!
+//! let table = buckets.as_ptr();
+//! let found = Prefetcher::<city::Hash64>::new()
+//!     .hash(&["hello", "rust", "world"], |h| table.wrapping_add(h as usize & MASK))
+//!     .filter(|&(key, h)| buckets[h as usize & MASK].contains(key))
+//!     .count();
+//!
+//! assert_eq!(found, 2);
+//! ```
+use std::collections::VecDeque;
+use std::fmt;
+use std::marker::PhantomData;
+
+use crate::hasher::FastHash;
+
+/// The default number of keys hashed and prefetched ahead of the caller.
+pub const BATCH: usize = 16;
+
+#[inline(always)]
+fn prefetch<T>(p: *const T) {
+    #[cfg(target_arch = "x86_64")]
+    unsafe {
+        use std::arch::x86_64::{_mm_prefetch, _MM_HINT_T0};
+
+        _mm_prefetch::<_MM_HINT_T0>(p as *const i8)
+    }
+
+    #[cfg(all(target_arch = "x86", target_feature = "sse"))]
+    unsafe {
+        use std::arch::x86::{_mm_prefetch, _MM_HINT_T0};
+
+        _mm_prefetch::<_MM_HINT_T0>(p as *const i8)
+    }
+
+    #[cfg(not(any(
+        target_arch = "x86_64",
+        all(target_arch = "x86", target_feature = "sse")
+    )))]
+    let _ = p;
+}
+
+/// Hashes keys with the `FastHash` family `H` and prefetches their buckets.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{prefetch::Prefetcher, xx, FastHash};
+///
+/// let table = vec![0_u64; 4096];
+/// let keys = vec![b"a".to_vec(), b"b".to_vec(), b"c".to_vec()];
+///
+/// let hashes = Prefetcher::<xx::Hash64>::with_seed(123)
+///     .batch(2)
+///     .hash(&keys, |h| table.as_ptr().wrapping_add(h as usize % table.len()))
+///     .map(|(_, h)| h)
+///     .collect::<Vec<_>>();
+///
+/// assert_eq!(hashes[2], xx::Hash64::hash_with_seed(b"c", 123));
+/// ```
+pub struct Prefetcher<H: FastHash> {
+    seed: Option<H::Seed>,
+    batch: usize,
+    _hash: PhantomData<H>,
+}
+
+impl<H: FastHash> Prefetcher<H> {
+    /// Constructs a `Prefetcher` that hashes keys without a seed, as `H::hash` does.
+    #[inline(always)]
+    pub fn new() -> Self {
+        Prefetcher {
+            seed: None,
+            batch: BATCH,
+            _hash: PhantomData,
+        }
+    }
+
+    /// Constructs a `Prefetcher` that hashes keys with `seed`.
+    #[inline(always)]
+    pub fn with_seed(seed: H::Seed) -> Self {
+        Prefetcher {
+            seed: Some(seed),
+            batch: BATCH,
+            _hash: PhantomData,
+        }
+    }
+
+    /// Sets the number of keys hashed and prefetched at a time.
+    ///
+    /// A larger batch hides more latency but holds more cache lines in flight;
+    /// the number of outstanding misses a core can track is the practical limit.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `batch` is zero.
+    #[inline(always)]
+    pub fn batch(mut self, batch: usize) -> Self {
+        assert!(batch > 0, "batch must not be empty");
+
+        self.batch = batch;
+        self
+    }
+
+    /// Returns an iterator of `(key, hash)` pairs over `keys`, in their original order,
+    /// that prefetches `bucket(hash)` one batch before the pair is yielded.
+    #[inline(always)]
+    pub fn hash<I, F, T>(&self, keys: I, bucket: F) -> Prefetched<H, I::IntoIter, F>
+    where
+        I: IntoIterator,
+        I::Item: AsRef<[u8]>,
+        F: Fn(H::Hash) -> *const T,
+    {
+        Prefetched {
+            keys: keys.into_iter(),
+            bucket,
+            seed: self.seed,
+            batch: self.batch,
+            pending: VecDeque::with_capacity(self.batch * 2),
+            done: false,
+        }
+    }
+}
+
+impl<H: FastHash> Default for Prefetcher<H> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<H: FastHash> Clone for Prefetcher<H> {
+    fn clone(&self) -> Self {
+        Prefetcher {
+            seed: self.seed,
+            batch: self.batch,
+            _hash: PhantomData,
+        }
+    }
+}
+
+impl<H: FastHash> fmt::Debug for Prefetcher<H> {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("Prefetcher")
+            .field("batch", &self.batch)
+            .finish()
+    }
+}
+
+/// An iterator of `(key, hash)` pairs whose buckets have been prefetched.
+///
+/// It is created by `Prefetcher::hash`, and keeps between one and two batches of
+/// hashed keys ahead of the caller.
+pub struct Prefetched<H: FastHash, I: Iterator, F> {
+    keys: I,
+    bucket: F,
+    seed: Option<H::Seed>,
+    batch: usize,
+    pending: VecDeque<(I::Item, H::Hash)>,
+    done: bool,
+}
+
+impl<H, I, F, T> Prefetched<H, I, F>
+where
+    H: FastHash,
+    I: Iterator,
+    I::Item: AsRef<[u8]>,
+    F: Fn(H::Hash) -> *const T,
+{
+    fn fill(&mut self) {
+        for _ in 0..self.batch {
+            match self.keys.next() {
+                Some(key) => {
+                    let hash = match self.seed {
+                        Some(seed) => H::hash_with_seed(&key, seed),
+                        None => H::hash(&key),
+                    };
+
+                    prefetch((self.bucket)(hash));
+
+                    self.pending.push_back((key, hash));
+                }
+                None => {
+                    self.done = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+impl<H, I, F, T> Iterator for Prefetched<H, I, F>
+where
+    H: FastHash,
+    I: Iterator,
+    I::Item: AsRef<[u8]>,
+    F: Fn(H::Hash) -> *const T,
+{
+    type Item = (I::Item, H::Hash);
+
+    #[inline]
+    fn next(&mut self) -> Option<Self::Item> {
+        // keep a full batch in flight behind the pair being yielded
+        while self.pending.len() <= self.batch && !self.done {
+            self.fill();
+        }
+
+        self.pending.pop_front()
+    }
+
+    #[inline]
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        let (lower, upper) = self.keys.size_hint();
+        let n = self.pending.len();
+
+        (
+            lower.saturating_add(n),
+            upper.and_then(|upper| upper.checked_add(n)),
+        )
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::cell::RefCell;
+
+    use crate::city;
+
+    use super::*;
+
+    #[test]
+    fn test_pairs_in_order() {
+        let keys = (0..100_u32)
+            .map(|i| i.to_le_bytes().repeat(i as usize % 7))
+            .collect::<Vec<_>>();
+
+        for &batch in &[1, 3, 16, 200] {
+            let pairs = Prefetcher::<city::Hash64>::with_seed(42)
+                .batch(batch)
+                .hash(&keys, |h| h as usize as *const u8)
+                .collect::<Vec<_>>();
+
+            assert_eq!(pairs.len(), keys.len());
+
+            for (key, &(k, h)) in keys.iter().zip(pairs.iter()) {
+                assert_eq!(k, key);
+                assert_eq!(h, city::Hash64::hash_with_seed(key, 42));
+            }
+        }
+    }
+
+    #[test]
+    fn test_prefetch_runs_ahead() {
+        let keys = (0..40_u8).map(|i| vec![i]).collect::<Vec<_>>();
+        let prefetched = RefCell::new(0);
+        let mut it = Prefetcher::<city::Hash64>::new().batch(8).hash(&keys, |_| {
+            *prefetched.borrow_mut() += 1;
+            std::ptr::null::<u8>()
+        });
+
+        it.next();
+        assert_eq!(*prefetched.borrow(), 16);
+
+        for _ in 0..8 {
+            it.next();
+        }
+        assert_eq!(*prefetched.borrow(), 24);
+        assert_eq!(it.count(), 31);
+        assert_eq!(*prefetched.borrow(), 40);
+    }
+}
@@ -0,0 +1,174 @@
+//! `rapidhash`, the official successor of `wyhash`
+//!
+//! by Nicolas De Carli
+//!
+//! https://github.com/Nicoshev/rapidhash
+//!
+//! * `rapidhash` keeps the `wyhash` mixing function but reads keys of 4 to 16 bytes
+//!   with fewer dependent operations, and mixes 17 to 48 bytes without a loop
+//! * `rapidhash` passes all [`SMHasher`](https://github.com/rurban/smhasher) tests
+//! * An unseeded hash uses the reference default seed `SEED`, as `rapidhash()` does
+//! * The fixed-width entry points such as `hash_u64` are compiled for their
+//!   length, so that every length branch is folded away
+//!
+//! # Example
+//!
+//! ```
+//! use std::hash::{Hash, Hasher};
+//!
+//! use fasthash::{rapid, RapidHasher};
+//!
+//! fn hash<T: Hash>(t: &T) -> u64 {
+//!     let mut s: RapidHasher = Default::default();
+//!     t.hash(&mut s);
+//!     s.finish()
+//! }
+//!
+//! let h = rapid::hash64(b"hello world\xff");
+//!
+//! assert_eq!(h, hash(&"hello world"));
+//! ```
+//!
+use std::os::raw::c_void;
+
+use crate::ffi;
+
+use crate::hasher::FastHash;
+
+/// The default seed of the reference `rapidhash()`.
+pub const SEED: u64 = 0xbdd8_9aa9_8270_4029;
+
+/// `rapidhash` 64-bit hash functions
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{rapid::Hash64, FastHash};
+///
+/// assert_eq!(Hash64::hash(b"hello"), 2188375479838694330);
+/// assert_eq!(Hash64::hash_with_seed(b"hello", 123), 18174563816846608361);
+/// assert_eq!(Hash64::hash(b"helloworld"), 14532706609692926305);
+/// ```
+#[derive(Clone, Default)]
+pub struct Hash64;
+
+impl FastHash for Hash64 {
+    type Hash = u64;
+    type Seed = u64;
+
+    #[inline(always)]
+    fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
+        unsafe {
+            ffi::rapidhash(
+                bytes.as_ref().as_ptr() as *const c_void,
+                bytes.as_ref().len(),
+                seed,
+            )
+        }
+    }
+
+    #[inline(always)]
+    fn hash<T: AsRef<[u8]>>(bytes: T) -> u64 {
+        Self::hash_with_seed(bytes, SEED)
+    }
+}
+
+trivial_hasher! {
+    /// # Example
+    ///
+    /// ```
+    /// use std::hash::Hasher;
+    ///
+    /// use fasthash::{rapid::Hasher64, FastHasher};
+    ///
+    /// let mut h = Hasher64::new();
+    ///
+    /// h.write(b"hello");
+    /// assert_eq!(h.finish(), 2188375479838694330);
+    ///
+    /// h.write(b"world");
+    /// assert_eq!(h.finish(), 14532706609692926305);
+    /// ```
+    Hasher64(Hash64) -> u64
+}
+
+/// `rapidhash` 64-bit hash functions for a byte array.
+#[inline(always)]
+pub fn hash64<T: AsRef<[u8]>>(v: T) -> u64 {
+    Hash64::hash(v)
+}
+
+/// `rapidhash` 64-bit hash function for a byte array.
+/// For convenience, a 64-bit seed is also hashed into the result.
+#[inline(always)]
+pub fn hash64_with_seed<T: AsRef<[u8]>>(v: T, seed: u64) -> u64 {
+    Hash64::hash_with_seed(v, seed)
+}
+
+/// `rapidhash` 64-bit hash function for a `u32`, the same as hashing its little-endian bytes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::rapid;
+///
+/// assert_eq!(rapid::hash_u32(123, rapid::SEED), rapid::hash64(123_u32.to_le_bytes()));
+/// ```
+#[inline(always)]
+pub fn hash_u32(v: u32, seed: u64) -> u64 {
+    record_hash!(Hash64, 4);
+
+    unsafe { ffi::rapidhash_fixed4(v.to_le_bytes().as_ptr() as *const c_void, seed) }
+}
+
+/// `rapidhash` 64-bit hash function for a `u64`, the same as hashing its little-endian bytes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::rapid;
+///
+/// assert_eq!(rapid::hash_u64(123, rapid::SEED), rapid::hash64(123_u64.to_le_bytes()));
+/// ```
+#[inline(always)]
+pub fn hash_u64(v: u64, seed: u64) -> u64 {
+    record_hash!(Hash64, 8);
+
+    unsafe { ffi::rapidhash_fixed8(v.to_le_bytes().as_ptr() as *const c_void, seed) }
+}
+
+/// `rapidhash` 64-bit hash function for a `u128`, the same as hashing its little-endian bytes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::rapid;
+///
+/// assert_eq!(rapid::hash_u128(123, rapid::SEED), rapid::hash64(123_u128.to_le_bytes()));
+/// ```
+#[inline(always)]
+pub fn hash_u128(v: u128, seed: u64) -> u64 {
+    record_hash!(Hash64, 16);
+
+    unsafe { ffi::rapidhash_fixed16(v.to_le_bytes().as_ptr() as *const c_void, seed) }
+}
+
+/// `rapidhash` 64-bit hash function for a 32-byte key, such as a SHA-256 digest.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::rapid;
+///
+/// let key = [7_u8; 32];
+///
+/// assert_eq!(rapid::hash_bytes32(&key, rapid::SEED), rapid::hash64(&key[..]));
+/// ```
+#[inline(always)]
+pub fn hash_bytes32(v: &[u8; 32], seed: u64) -> u64 {
+    record_hash!(Hash64, 32);
+
+    unsafe { ffi::rapidhash_fixed32(v.as_ptr() as *const c_void, seed) }
+}
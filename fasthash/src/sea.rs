@@ -54,11 +54,15 @@ impl FastHash for Hash64 {
 
     #[inline(always)]
     fn hash<T: AsRef<[u8]>>(bytes: T) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         seahash::hash(bytes.as_ref())
     }
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: (u64, u64, u64, u64)) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         seahash::hash_seeded(bytes.as_ref(), seed.0, seed.1, seed.2, seed.3)
     }
 }
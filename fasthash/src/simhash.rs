@@ -0,0 +1,397 @@
+//! `SimHash` fingerprints for near-duplicate detection over weighted tokens.
+//!
+//! by Moses S. Charikar
+//!
+//! https://en.wikipedia.org/wiki/SimHash
+//!
+//! Every token is hashed with the underlying `FastHash` family, and each
+//! bit of the hash adds or subtracts the token weight from a per-bit counter.
+//! The fingerprint keeps the sign of each counter, so similar token
+//! streams produce fingerprints with a small Hamming distance.
+//!
+//! The counters are a flat array updated without branches,
+//! which the compiler turns into SIMD adds.
+//!
+//! # Example
+//!
+//! ```
+//! use fasthash::{city, simhash::{hamming_distance, SimHash}};
+//!
+//! let a = SimHash::<city::Hash64>::from_tokens(
+//!     "the quick brown fox jumps over the lazy dog".split(' '),
+//! );
+//! let b = SimHash::<city::Hash64>::from_tokens(
+//!     "the quick brown fox jumped over the lazy dog".split(' '),
+//! );
+//!
+//! assert!(hamming_distance(a, b) < 32);
+//! ```
+//!
+use std::collections::HashMap;
+use std::marker::PhantomData;
+use std::mem;
+
+use num_traits::{AsPrimitive, PrimInt};
+
+use crate::hasher::FastHash;
+
+const MAX_BITS: usize = 128;
+
+/// Returns the number of differing bits between two fingerprints.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::simhash::hamming_distance;
+///
+/// assert_eq!(hamming_distance(0b1011_u64, 0b0110_u64), 3);
+/// ```
+#[inline(always)]
+pub fn hamming_distance<T: PrimInt>(a: T, b: T) -> u32 {
+    (a ^ b).count_ones()
+}
+
+/// A `SimHash` fingerprint builder.
+///
+/// The fingerprint has the same width as the hash family output,
+/// so `city::Hash64` builds 64-bit and `xxh3::Hash128` builds 128-bit fingerprints.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{simhash::SimHash, xxh3};
+///
+/// let mut s = SimHash::<xxh3::Hash128>::new();
+///
+/// s.insert_weighted("fasthash", 3);
+/// s.insert("rust");
+///
+/// let fp: u128 = s.fingerprint();
+///
+/// assert_eq!(fp, s.clone().fingerprint());
+/// ```
+#[derive(Clone)]
+pub struct SimHash<H: FastHash> {
+    counters: [i64; MAX_BITS],
+    phantom: PhantomData<H>,
+}
+
+impl<H: FastHash> Default for SimHash<H>
+where
+    H::Hash: AsPrimitive<u128>,
+    u128: AsPrimitive<H::Hash>,
+{
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<H: FastHash> SimHash<H>
+where
+    H::Hash: AsPrimitive<u128>,
+    u128: AsPrimitive<H::Hash>,
+{
+    const BITS: usize = mem::size_of::<H::Hash>() * 8;
+
+    /// Constructs an empty `SimHash` builder.
+    #[inline(always)]
+    pub fn new() -> Self {
+        SimHash {
+            counters: [0; MAX_BITS],
+            phantom: PhantomData,
+        }
+    }
+
+    /// Builds the fingerprint of a stream of tokens, each with weight 1.
+    pub fn from_tokens<I, T>(tokens: I) -> H::Hash
+    where
+        I: IntoIterator<Item = T>,
+        T: AsRef<[u8]>,
+    {
+        let mut s = Self::new();
+
+        for token in tokens {
+            s.insert(token);
+        }
+
+        s.fingerprint()
+    }
+
+    /// Builds the fingerprint of a stream of weighted tokens.
+    pub fn from_weighted_tokens<I, T>(tokens: I) -> H::Hash
+    where
+        I: IntoIterator<Item = (T, i64)>,
+        T: AsRef<[u8]>,
+    {
+        let mut s = Self::new();
+
+        for (token, weight) in tokens {
+            s.insert_weighted(token, weight);
+        }
+
+        s.fingerprint()
+    }
+
+    /// Adds a token with weight 1.
+    #[inline(always)]
+    pub fn insert<T: AsRef<[u8]>>(&mut self, token: T) {
+        self.insert_weighted(token, 1)
+    }
+
+    /// Adds a token with the given weight.
+    #[inline(always)]
+    pub fn insert_weighted<T: AsRef<[u8]>>(&mut self, token: T, weight: i64) {
+        self.insert_hash(H::hash(token).as_(), weight)
+    }
+
+    /// Adds an already hashed token with the given weight.
+    pub fn insert_hash(&mut self, h: u128, weight: i64) {
+        let lo = h as u64;
+        let hi = (h >> 64) as u64;
+        let (lo_counters, hi_counters) = self.counters.split_at_mut(64);
+
+        accumulate(lo_counters, lo, weight);
+
+        if Self::BITS > 64 {
+            accumulate(hi_counters, hi, weight);
+        }
+    }
+
+    /// Merges the counters of another builder, as if its tokens were inserted here.
+    pub fn merge(&mut self, other: &Self) {
+        for (c, &o) in self.counters.iter_mut().zip(other.counters.iter()) {
+            *c = c.wrapping_add(o);
+        }
+    }
+
+    /// Resets all counters.
+    pub fn clear(&mut self) {
+        self.counters = [0; MAX_BITS];
+    }
+
+    /// Returns the fingerprint, one bit per positive counter.
+    pub fn fingerprint(&self) -> H::Hash {
+        let fp = self.counters[..Self::BITS]
+            .iter()
+            .enumerate()
+            .fold(0_u128, |fp, (i, &c)| fp | (u128::from(c > 0) << i));
+
+        fp.as_()
+    }
+}
+
+#[inline(always)]
+fn accumulate(counters: &mut [i64], h: u64, weight: i64) {
+    for (i, c) in counters[..64].iter_mut().enumerate() {
+        // bit set => +weight, bit clear => -weight
+        let sign = (((h >> i) & 1) as i64) * 2 - 1;
+
+        *c = c.wrapping_add(sign * weight);
+    }
+}
+
+/// A Hamming-distance index for near-neighbor lookup of `SimHash` fingerprints.
+///
+/// The fingerprint is split into `max_distance + 1` blocks; by the pigeonhole
+/// principle two fingerprints within `max_distance` bits share at least one
+/// block exactly, so every block is indexed in its own table and only the
+/// candidates from matching blocks are compared bit by bit.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::simhash::SimHashIndex;
+///
+/// let mut index = SimHashIndex::new(3);
+///
+/// let a = index.insert(0xFFFF_0000_FFFF_0000_u64);
+/// let b = index.insert(0x0000_FFFF_0000_FFFF_u64);
+///
+/// assert_eq!(index.query(0xFFFF_0000_FFFF_0007), vec![(a, 3)]);
+/// assert_eq!(index.query(0x0000_FFFF_0000_FFFF), vec![(b, 0)]);
+/// assert!(index.query(0x1234_5678_9ABC_DEF0).is_empty());
+/// ```
+#[derive(Clone, Debug)]
+pub struct SimHashIndex<T> {
+    max_distance: u32,
+    blocks: Vec<(u32, u32)>,
+    tables: Vec<HashMap<u128, Vec<usize>>>,
+    fingerprints: Vec<T>,
+}
+
+impl<T> SimHashIndex<T>
+where
+    T: PrimInt + AsPrimitive<u128>,
+{
+    /// Constructs an index answering queries within `max_distance` bits.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `max_distance` is not less than the fingerprint width.
+    pub fn new(max_distance: u32) -> Self {
+        let bits = (mem::size_of::<T>() * 8) as u32;
+
+        assert!(
+            max_distance < bits,
+            "max distance must be less than the fingerprint width"
+        );
+
+        let n = max_distance + 1;
+
+        let blocks = (0..n)
+            .map(|i| {
+                let start = bits * i / n;
+                let end = bits * (i + 1) / n;
+
+                (start, end - start)
+            })
+            .collect::<Vec<_>>();
+        let tables = vec![HashMap::new(); blocks.len()];
+
+        SimHashIndex {
+            max_distance,
+            blocks,
+            tables,
+            fingerprints: Vec::new(),
+        }
+    }
+
+    /// Returns the maximum distance answered by `query`.
+    #[inline(always)]
+    pub fn max_distance(&self) -> u32 {
+        self.max_distance
+    }
+
+    /// Returns the number of indexed fingerprints.
+    #[inline(always)]
+    pub fn len(&self) -> usize {
+        self.fingerprints.len()
+    }
+
+    /// Returns `true` if the index is empty.
+    #[inline(always)]
+    pub fn is_empty(&self) -> bool {
+        self.fingerprints.is_empty()
+    }
+
+    /// Returns the fingerprint with the given id.
+    #[inline(always)]
+    pub fn get(&self, id: usize) -> Option<T> {
+        self.fingerprints.get(id).cloned()
+    }
+
+    #[inline(always)]
+    fn block(fp: u128, (shift, width): (u32, u32)) -> u128 {
+        let mask = if width >= 128 {
+            u128::max_value()
+        } else {
+            (1 << width) - 1
+        };
+
+        (fp >> shift) & mask
+    }
+
+    /// Inserts a fingerprint and returns its id.
+    pub fn insert(&mut self, fp: T) -> usize {
+        let id = self.fingerprints.len();
+        let v = fp.as_();
+
+        for (table, &block) in self.tables.iter_mut().zip(&self.blocks) {
+            table
+                .entry(Self::block(v, block))
+                .or_insert_with(Vec::new)
+                .push(id);
+        }
+
+        self.fingerprints.push(fp);
+
+        id
+    }
+
+    /// Returns the ids and distances of all fingerprints within `max_distance`,
+    /// ordered by distance then id.
+    pub fn query(&self, fp: T) -> Vec<(usize, u32)> {
+        let v = fp.as_();
+        let mut found = self
+            .tables
+            .iter()
+            .zip(&self.blocks)
+            .filter_map(|(table, &block)| table.get(&Self::block(v, block)))
+            .flatten()
+            .map(|&id| (id, hamming_distance(self.fingerprints[id], fp)))
+            .filter(|&(_, d)| d <= self.max_distance)
+            .collect::<Vec<_>>();
+
+        found.sort_by_key(|&(id, d)| (d, id));
+        found.dedup();
+        found
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::xxh3;
+
+    #[test]
+    fn test_simhash_similarity() {
+        let words = (0..200_u32).map(|i| i.to_le_bytes()).collect::<Vec<_>>();
+        let mut other = words.clone();
+
+        other[7] = 1000_u32.to_le_bytes();
+
+        let a = SimHash::<xxh3::Hash64>::from_tokens(&words);
+        let b = SimHash::<xxh3::Hash64>::from_tokens(&other);
+        let c = SimHash::<xxh3::Hash64>::from_tokens((500..700_u32).map(|i| i.to_le_bytes()));
+
+        assert!(hamming_distance(a, b) < hamming_distance(a, c));
+    }
+
+    #[test]
+    fn test_simhash_weights() {
+        let mut s = SimHash::<xxh3::Hash64>::new();
+
+        s.insert_weighted("heavy", 100);
+        s.insert("light");
+
+        assert_eq!(s.fingerprint(), xxh3::Hash64::hash("heavy"));
+    }
+
+    #[test]
+    fn test_simhash_merge() {
+        let mut a = SimHash::<xxh3::Hash64>::new();
+        let mut b = SimHash::<xxh3::Hash64>::new();
+        let mut c = SimHash::<xxh3::Hash64>::new();
+
+        a.insert("a");
+        b.insert_weighted("b", 2);
+        c.insert("a");
+        c.insert_weighted("b", 2);
+
+        a.merge(&b);
+
+        assert_eq!(a.fingerprint(), c.fingerprint());
+    }
+
+    #[test]
+    fn test_simhash_index() {
+        let mut index = SimHashIndex::new(4);
+        let base = 0x0123_4567_89AB_CDEF_u64;
+
+        for i in 0..64 {
+            index.insert(base ^ (1 << i));
+        }
+
+        let found = index.query(base);
+
+        assert_eq!(found.len(), 64);
+        assert!(found.iter().all(|&(_, d)| d == 1));
+        assert_eq!(index.query(base ^ 0b11111_u64 << 30).len(), 5);
+    }
+
+    #[test]
+    #[should_panic(expected = "max distance must be less than the fingerprint width")]
+    fn test_simhash_index_max_distance() {
+        SimHashIndex::<u64>::new(u32::max_value());
+    }
+}
@@ -72,6 +72,8 @@ impl FastHash for Hash32 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         let mut hash1 = u64::from(seed);
         let mut hash2 = u64::from(seed);
 
@@ -127,6 +129,8 @@ impl FastHash for Hash64 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         let mut hash1 = seed;
         let mut hash2 = seed;
 
@@ -191,6 +195,8 @@ impl FastHash for Hash128 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u128) -> u128 {
+        record_hash!(bytes.as_ref().len());
+
         let mut hi = (seed >> 64) as u64;
         let mut lo = seed as u64;
 
@@ -95,6 +95,8 @@ pub mod t1ha2 {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+            record_hash!(bytes.as_ref().len());
+
             unsafe {
                 ffi::t1ha2_atonce(
                     bytes.as_ref().as_ptr() as *const _,
@@ -134,6 +136,8 @@ pub mod t1ha2 {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u128 {
+            record_hash!(bytes.as_ref().len());
+
             let mut hi = 0;
 
             let lo = unsafe {
@@ -280,6 +284,8 @@ pub mod t1ha1 {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+            record_hash!(bytes.as_ref().len());
+
             unsafe {
                 ffi::t1ha1_le(
                     bytes.as_ref().as_ptr() as *const _,
@@ -332,6 +338,8 @@ pub mod t1ha1 {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+            record_hash!(bytes.as_ref().len());
+
             unsafe {
                 ffi::t1ha1_be(
                     bytes.as_ref().as_ptr() as *const _,
@@ -401,6 +409,8 @@ pub mod t1ha0 {
 
         #[inline(always)]
         fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+            record_hash!(bytes.as_ref().len());
+
             unsafe {
                 T1HA0.unwrap_or(ffi::t1ha0_64)(
                     bytes.as_ref().as_ptr() as *const _,
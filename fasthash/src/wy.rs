@@ -0,0 +1,198 @@
+//! `wyhash`, a fast portable hash function based on 64x64 to 128-bit multiplication
+//!
+//! by Wang Yi <godspeed_china@yeah.net>
+//!
+//! https://github.com/wangyi-fudan/wyhash
+//!
+//! * This is the final version 4.2 of the algorithm
+//! * Keys up to 16 bytes are read with at most four loads and mixed with
+//!   three multiplications, which makes `wyhash` one of the fastest
+//!   high-quality hashes for short keys
+//! * `wyhash` passes all [`SMHasher`](https://github.com/rurban/smhasher) tests
+//! * The fixed-width entry points such as `hash_u64` are compiled for their
+//!   length, so that every length branch is folded away
+//!
+//! # Example
+//!
+//! ```
+//! use std::hash::{Hash, Hasher};
+//!
+//! use fasthash::{wy, WyHasher};
+//!
+//! fn hash<T: Hash>(t: &T) -> u64 {
+//!     let mut s: WyHasher = Default::default();
+//!     t.hash(&mut s);
+//!     s.finish()
+//! }
+//!
+//! let h = wy::hash64(b"hello world\xff");
+//!
+//! assert_eq!(h, hash(&"hello world"));
+//! ```
+//!
+use std::os::raw::c_void;
+
+use crate::ffi;
+
+use crate::hasher::FastHash;
+
+/// `wyhash` 64-bit hash functions
+///
+/// # Example
+///
+/// ```
+/// use fasthash::{wy::Hash64, FastHash};
+///
+/// assert_eq!(Hash64::hash(b"hello"), 5306810434294928543);
+/// assert_eq!(Hash64::hash_with_seed(b"hello", 123), 13497503053879429928);
+/// assert_eq!(Hash64::hash(b"helloworld"), 16795529425300568615);
+/// ```
+#[derive(Clone, Default)]
+pub struct Hash64;
+
+impl FastHash for Hash64 {
+    type Hash = u64;
+    type Seed = u64;
+
+    #[inline(always)]
+    fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
+        unsafe {
+            ffi::wyhash(
+                bytes.as_ref().as_ptr() as *const c_void,
+                bytes.as_ref().len(),
+                seed,
+            )
+        }
+    }
+}
+
+trivial_hasher! {
+    /// # Example
+    ///
+    /// ```
+    /// use std::hash::Hasher;
+    ///
+    /// use fasthash::{wy::Hasher64, FastHasher};
+    ///
+    /// let mut h = Hasher64::new();
+    ///
+    /// h.write(b"hello");
+    /// assert_eq!(h.finish(), 5306810434294928543);
+    ///
+    /// h.write(b"world");
+    /// assert_eq!(h.finish(), 16795529425300568615);
+    /// ```
+    Hasher64(Hash64) -> u64
+}
+
+/// `wyhash` 64-bit hash functions for a byte array.
+#[inline(always)]
+pub fn hash64<T: AsRef<[u8]>>(v: T) -> u64 {
+    Hash64::hash(v)
+}
+
+/// `wyhash` 64-bit hash function for a byte array.
+/// For convenience, a 64-bit seed is also hashed into the result.
+#[inline(always)]
+pub fn hash64_with_seed<T: AsRef<[u8]>>(v: T, seed: u64) -> u64 {
+    Hash64::hash_with_seed(v, seed)
+}
+
+/// `wyhash` 64-bit hash function for a `u32`, the same as hashing its little-endian bytes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::wy;
+///
+/// assert_eq!(wy::hash_u32(123, 0), wy::hash64(123_u32.to_le_bytes()));
+/// ```
+#[inline(always)]
+pub fn hash_u32(v: u32, seed: u64) -> u64 {
+    record_hash!(Hash64, 4);
+
+    unsafe { ffi::wyhash_fixed4(v.to_le_bytes().as_ptr() as *const c_void, seed) }
+}
+
+/// `wyhash` 64-bit hash function for a `u64`, the same as hashing its little-endian bytes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::wy;
+///
+/// assert_eq!(wy::hash_u64(123, 0), wy::hash64(123_u64.to_le_bytes()));
+/// ```
+#[inline(always)]
+pub fn hash_u64(v: u64, seed: u64) -> u64 {
+    record_hash!(Hash64, 8);
+
+    unsafe { ffi::wyhash_fixed8(v.to_le_bytes().as_ptr() as *const c_void, seed) }
+}
+
+/// `wyhash` 64-bit hash function for a `u128`, the same as hashing its little-endian bytes.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::wy;
+///
+/// assert_eq!(wy::hash_u128(123, 0), wy::hash64(123_u128.to_le_bytes()));
+/// ```
+#[inline(always)]
+pub fn hash_u128(v: u128, seed: u64) -> u64 {
+    record_hash!(Hash64, 16);
+
+    unsafe { ffi::wyhash_fixed16(v.to_le_bytes().as_ptr() as *const c_void, seed) }
+}
+
+/// `wyhash` 64-bit hash function for a 32-byte key, such as a SHA-256 digest.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::wy;
+///
+/// let key = [7_u8; 32];
+///
+/// assert_eq!(wy::hash_bytes32(&key, 0), wy::hash64(&key[..]));
+/// ```
+#[inline(always)]
+pub fn hash_bytes32(v: &[u8; 32], seed: u64) -> u64 {
+    record_hash!(Hash64, 32);
+
+    unsafe { ffi::wyhash_fixed32(v.as_ptr() as *const c_void, seed) }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_vectors() {
+        let messages: [&[u8]; 7] = [
+            b"",
+            b"a",
+            b"abc",
+            b"message digest",
+            b"abcdefghijklmnopqrstuvwxyz",
+            b"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+            b"12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+        ];
+        let expected = [
+            0x93228a4de0eec5a2,
+            0xc5bac3db178713c4,
+            0xa97f2f7b1d9b3314,
+            0x786d1f1df3801df4,
+            0xdca5a8138ad37c87,
+            0xb9e734f117cfaf70,
+            0x6cc5eab49a92d617,
+        ];
+
+        for (seed, (msg, &hash)) in messages.iter().zip(expected.iter()).enumerate() {
+            assert_eq!(hash64_with_seed(msg, seed as u64), hash);
+        }
+    }
+}
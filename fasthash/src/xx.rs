@@ -29,12 +29,13 @@
 //! ```
 //!
 use std::hash::Hasher;
+use std::io::IoSlice;
 use std::os::raw::c_void;
 use std::ptr::NonNull;
 
 use crate::ffi;
 
-use crate::hasher::{FastHash, FastHasher, StreamHasher};
+use crate::hasher::{gather, stream_vectored, FastHash, FastHasher, StreamHasher};
 
 /// xxHash 32-bit hash functions
 ///
@@ -56,6 +57,8 @@ impl FastHash for Hash32 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u32) -> u32 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::XXH32(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -64,6 +67,24 @@ impl FastHash for Hash32 {
             )
         }
     }
+
+    #[inline(always)]
+    fn hash_vectored(bufs: &[IoSlice]) -> Self::Hash {
+        Self::hash_vectored_with_seed(bufs, Default::default())
+    }
+
+    #[inline(always)]
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: Self::Seed) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher32::with_seed(seed);
+            h.write_vectored(bufs);
+            h.finish() as u32
+        } else {
+            gather(bufs, |bytes| Self::hash_with_seed(bytes, seed))
+        }
+    }
 }
 
 /// xxHash 64-bit hash functions
@@ -86,6 +107,8 @@ impl FastHash for Hash64 {
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: u64) -> u64 {
+        record_hash!(bytes.as_ref().len());
+
         unsafe {
             ffi::XXH64(
                 bytes.as_ref().as_ptr() as *const c_void,
@@ -94,6 +117,24 @@ impl FastHash for Hash64 {
             )
         }
     }
+
+    #[inline(always)]
+    fn hash_vectored(bufs: &[IoSlice]) -> Self::Hash {
+        Self::hash_vectored_with_seed(bufs, Default::default())
+    }
+
+    #[inline(always)]
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: Self::Seed) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher64::with_seed(seed);
+            h.write_vectored(bufs);
+            h.finish()
+        } else {
+            gather(bufs, |bytes| Self::hash_with_seed(bytes, seed))
+        }
+    }
 }
 
 /// xxHash 32-bit hash functions for a byte array.
@@ -122,6 +163,62 @@ pub fn hash64_with_seed<T: AsRef<[u8]>>(v: T, seed: u64) -> u64 {
     Hash64::hash_with_seed(v, seed)
 }
 
+/// xxHash 64-bit hash function for a fixed-length array.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash64`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::xx;
+///
+/// let key = [7_u8; 12];
+///
+/// assert_eq!(xx::hash_array(&key), xx::hash64(&key));
+/// ```
+#[inline(always)]
+pub fn hash_array<const N: usize>(v: &[u8; N]) -> u64 {
+    hash_array_with_seed(v, 0)
+}
+
+/// xxHash 64-bit hash function for a fixed-length array.
+/// For convenience, a 64-bit seed is also hashed into the result.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::xx;
+///
+/// let key = [7_u8; 24];
+///
+/// assert_eq!(xx::hash_array_with_seed(&key, 123), xx::hash64_with_seed(&key, 123));
+/// ```
+#[inline(always)]
+pub fn hash_array_with_seed<const N: usize>(v: &[u8; N], seed: u64) -> u64 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::XXH64_fixed4(p, seed),
+            8 => ffi::XXH64_fixed8(p, seed),
+            12 => ffi::XXH64_fixed12(p, seed),
+            16 => ffi::XXH64_fixed16(p, seed),
+            20 => ffi::XXH64_fixed20(p, seed),
+            24 => ffi::XXH64_fixed24(p, seed),
+            32 => ffi::XXH64_fixed32(p, seed),
+            64 => ffi::XXH64_fixed64(p, seed),
+            _ => return hash64_with_seed(&v[..], seed),
+        }
+    };
+
+    record_hash!(Hash64, N);
+
+    h
+}
+
 /// An implementation of `std::hash::Hasher`.
 ///
 /// # Example
@@ -296,3 +393,32 @@ impl FastHasher for Hasher64 {
 impl StreamHasher for Hasher64 {}
 
 impl_build_hasher!(Hasher64, Hash64);
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_hash_vectored_matches_concat() {
+        let data = (0..8192_u32)
+            .map(|i| (i * 7 >> 2) as u8)
+            .collect::<Vec<_>>();
+
+        for &len in &[0, 100, 1023, 1024, 5000, 8192] {
+            let (a, rest) = data[..len].split_at(len / 3);
+            let (b, c) = rest.split_at(rest.len() / 2);
+            let bufs = [IoSlice::new(a), IoSlice::new(b), IoSlice::new(c)];
+
+            assert_eq!(Hash32::hash_vectored(&bufs), Hash32::hash(&data[..len]));
+            assert_eq!(
+                Hash32::hash_vectored_with_seed(&bufs, 123),
+                Hash32::hash_with_seed(&data[..len], 123)
+            );
+            assert_eq!(Hash64::hash_vectored(&bufs), Hash64::hash(&data[..len]));
+            assert_eq!(
+                Hash64::hash_vectored_with_seed(&bufs, 123),
+                Hash64::hash_with_seed(&data[..len], 123)
+            );
+        }
+    }
+}
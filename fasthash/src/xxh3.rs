@@ -1,9 +1,48 @@
 //! XXH3 is a new hash algorithm, featuring vastly improved speed performance for both small and large inputs.
-use std::hash::Hasher;
+//!
+//! On x86, the accumulate loop used for inputs longer than 240 bytes is built
+//! for scalar, SSE2 and AVX2 targets, and the widest one supported by the CPU
+//! is selected at runtime. All of them produce the same hashes.
+//!
+//! Seeded XXH3 derives a custom secret from the seed on every call above
+//! 240 bytes. A `Secret` can be derived once instead and passed to the
+//! `_with_secret` functions, or shared by a whole process with `SecretState`.
+//!
+//! # Example
+//!
+//! ```
+//! use std::collections::HashMap;
+//!
+//! use fasthash::xxh3::{self, Secret, SecretState};
+//!
+//! let secret = Secret::generate(b"dedup cache key");
+//! let data = vec![0_u8; 4096];
+//!
+//! assert_eq!(
+//!     xxh3::hash64_with_secret(&data, &secret),
+//!     xxh3::hash64_with_secret(&data, Secret::generate(b"dedup cache key"))
+//! );
+//!
+//! let mut map = HashMap::with_hasher(SecretState::new());
+//!
+//! map.insert(37, "a");
+//! assert_eq!(map.get(&37), Some(&"a"));
+//! ```
+//!
+use std::hash::{BuildHasher, Hasher};
+use std::io::IoSlice;
 use std::mem;
-use std::ptr::NonNull;
+use std::os::raw::c_void;
+use std::ptr;
 
-use crate::{FastHash, FastHasher, HasherExt, StreamHasher};
+use crate::hasher::{gather, stream_vectored};
+use crate::{FastHash, FastHasher, HasherExt, Seed, StreamHasher};
+
+/// Size in bytes of a `Secret`, the same as the built-in XXH3 secret.
+pub const SECRET_SIZE: usize = 192;
+
+/// Smallest secret in bytes accepted by the `_with_secret` functions.
+pub const SECRET_SIZE_MIN: usize = 136;
 
 /// 64-bit hash functions for a byte array.
 ///
@@ -34,6 +73,62 @@ pub fn hash64_with_seed<T: AsRef<[u8]>>(v: T, seed: u64) -> u64 {
     Hash64::hash_with_seed(v, seed)
 }
 
+/// 64-bit hash function for a fixed-length array.
+///
+/// Keys of 4, 8, 12, 16, 20, 24, 32 and 64 bytes are hashed by code compiled
+/// for that length, so no time is spent dispatching on the length or on the tail;
+/// other lengths fall back to `hash64`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::xxh3;
+///
+/// let key = [7_u8; 12];
+///
+/// assert_eq!(xxh3::hash_array(&key), xxh3::hash64(&key));
+/// ```
+#[inline(always)]
+pub fn hash_array<const N: usize>(v: &[u8; N]) -> u64 {
+    hash_array_with_seed(v, 0)
+}
+
+/// 64-bit hash function for a fixed-length array.
+/// For convenience, a 64-bit seed is also hashed into the result.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::xxh3;
+///
+/// let key = [7_u8; 24];
+///
+/// assert_eq!(xxh3::hash_array_with_seed(&key, 123), xxh3::hash64_with_seed(&key, 123));
+/// ```
+#[inline(always)]
+pub fn hash_array_with_seed<const N: usize>(v: &[u8; N], seed: u64) -> u64 {
+    let p = v.as_ptr() as *const c_void;
+
+    // `N` is a constant, so only one arm is left after monomorphization
+    let h = unsafe {
+        match N {
+            4 => ffi::XXH3_64bits_fixed4(p, seed),
+            8 => ffi::XXH3_64bits_fixed8(p, seed),
+            12 => ffi::XXH3_64bits_fixed12(p, seed),
+            16 => ffi::XXH3_64bits_fixed16(p, seed),
+            20 => ffi::XXH3_64bits_fixed20(p, seed),
+            24 => ffi::XXH3_64bits_fixed24(p, seed),
+            32 => ffi::XXH3_64bits_fixed32(p, seed),
+            64 => ffi::XXH3_64bits_fixed64(p, seed),
+            _ => return hash64_with_seed(&v[..], seed),
+        }
+    };
+
+    record_hash!(Hash64, N);
+
+    h
+}
+
 /// 128-bit hash function for a byte array.
 ///
 /// # Example
@@ -70,6 +165,227 @@ pub fn hash128_with_seed<T: AsRef<[u8]>>(v: T, seed: u64) -> u128 {
     Hash128::hash_with_seed(v, seed)
 }
 
+/// 64-bit hash function for a byte array, keyed with a custom secret.
+///
+/// # Panics
+///
+/// Panics if the secret is shorter than `SECRET_SIZE_MIN`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::xxh3::{self, Secret};
+///
+/// let secret = Secret::generate(b"key");
+///
+/// assert_ne!(
+///     xxh3::hash64_with_secret("hello world", &secret),
+///     xxh3::hash64("hello world")
+/// );
+/// ```
+#[inline(always)]
+pub fn hash64_with_secret<T: AsRef<[u8]>, S: AsRef<[u8]>>(v: T, secret: S) -> u64 {
+    let (bytes, secret) = (v.as_ref(), secret.as_ref());
+
+    assert!(secret.len() >= SECRET_SIZE_MIN, "secret is too short");
+
+    record_hash!(Hash64, bytes.len());
+
+    unsafe {
+        ffi::XXH3_64bits_withSecret_dispatch(
+            bytes.as_ptr() as *const _,
+            bytes.len(),
+            secret.as_ptr() as *const _,
+            secret.len(),
+        )
+    }
+}
+
+/// 128-bit hash function for a byte array, keyed with a custom secret.
+///
+/// # Panics
+///
+/// Panics if the secret is shorter than `SECRET_SIZE_MIN`.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::xxh3::{self, Secret};
+///
+/// let secret = Secret::generate(b"key");
+///
+/// assert_ne!(
+///     xxh3::hash128_with_secret("hello world", &secret),
+///     xxh3::hash128("hello world")
+/// );
+/// ```
+#[inline(always)]
+pub fn hash128_with_secret<T: AsRef<[u8]>, S: AsRef<[u8]>>(v: T, secret: S) -> u128 {
+    let (bytes, secret) = (v.as_ref(), secret.as_ref());
+
+    assert!(secret.len() >= SECRET_SIZE_MIN, "secret is too short");
+
+    record_hash!(Hash128, bytes.len());
+
+    let h = unsafe {
+        ffi::XXH3_128bits_withSecret_dispatch(
+            bytes.as_ptr() as *const _,
+            bytes.len(),
+            secret.as_ptr() as *const _,
+            secret.len(),
+        )
+    };
+
+    u128::from(h.low64) + (u128::from(h.high64) << 64)
+}
+
+/// A custom XXH3 secret.
+///
+/// Deriving a secret costs about as much as hashing a short key,
+/// so it should be generated once and reused.
+///
+/// # Example
+///
+/// ```
+/// use fasthash::xxh3::{Secret, SECRET_SIZE};
+///
+/// let a = Secret::generate(b"tenant-1");
+/// let b = Secret::generate(b"tenant-2");
+///
+/// assert_eq!(a.as_ref().len(), SECRET_SIZE);
+/// assert_ne!(a.as_ref(), b.as_ref());
+/// ```
+#[derive(Clone)]
+pub struct Secret([u8; SECRET_SIZE]);
+
+impl Secret {
+    /// Derives a secret from seed material of any length.
+    ///
+    /// Every 16 bytes of the secret are the 128-bit hash of the seed material
+    /// with the block index as seed, so any seed gives a high entropy secret.
+    pub fn generate<T: AsRef<[u8]>>(seed: T) -> Secret {
+        let seed = seed.as_ref();
+        let mut secret = [0; SECRET_SIZE];
+
+        for (i, block) in secret.chunks_mut(16).enumerate() {
+            block.copy_from_slice(&hash128_with_seed(seed, i as u64).to_le_bytes());
+        }
+
+        Secret(secret)
+    }
+
+    /// Generates a random secret.
+    pub fn random() -> Secret {
+        let key: [u64; 4] = Seed::gen().into();
+        let mut seed = [0; 32];
+
+        for (b, k) in seed.chunks_mut(8).zip(key.iter()) {
+            b.copy_from_slice(&k.to_le_bytes());
+        }
+
+        Secret::generate(&seed[..])
+    }
+
+    /// Returns the secret shared by the whole process, generated randomly on first use.
+    pub fn process() -> &'static Secret {
+        lazy_static! {
+            static ref PROCESS_SECRET: Secret = Secret::random();
+        }
+
+        &PROCESS_SECRET
+    }
+}
+
+impl AsRef<[u8]> for Secret {
+    #[inline(always)]
+    fn as_ref(&self) -> &[u8] {
+        &self.0
+    }
+}
+
+/// An XXH3 streaming state kept inline in the hasher.
+///
+/// A seeded or keyed state points at its own `customSecret`, which moves
+/// with the hasher, so the pointer is refreshed before the state is used.
+#[derive(Clone, Copy)]
+struct State {
+    inner: ffi::XXH3_state_t,
+    owns_secret: bool,
+}
+
+// The secret pointer only ever refers to a static secret or to the state itself.
+unsafe impl Send for State {}
+unsafe impl Sync for State {}
+
+impl State {
+    #[inline(always)]
+    fn reset<F>(reset: F) -> State
+    where
+        F: FnOnce(*mut ffi::XXH3_state_t),
+    {
+        let mut state = State {
+            inner: unsafe { mem::zeroed() },
+            owns_secret: false,
+        };
+
+        reset(&mut state.inner);
+        state.owns_secret = state.inner.secret == state.inner.customSecret.as_ptr() as *const _;
+        state
+    }
+
+    /// Points the state at a secret that outlives it, without copying it.
+    #[inline(always)]
+    fn with_static_secret<F>(secret: &'static Secret, reset: F) -> State
+    where
+        F: FnOnce(*mut ffi::XXH3_state_t, *const c_void, usize),
+    {
+        State::reset(|s| reset(s, secret.0.as_ptr() as *const _, SECRET_SIZE))
+    }
+
+    /// Copies `secret` into the state, so the hasher does not borrow it.
+    #[inline(always)]
+    fn with_secret<F>(secret: &Secret, reset: F) -> State
+    where
+        F: FnOnce(*mut ffi::XXH3_state_t, *const c_void, usize),
+    {
+        let mut state = State::reset(|s| reset(s, secret.0.as_ptr() as *const _, SECRET_SIZE));
+
+        unsafe {
+            ptr::copy_nonoverlapping(
+                secret.0.as_ptr(),
+                state.inner.customSecret.as_mut_ptr() as *mut u8,
+                SECRET_SIZE,
+            );
+        }
+        state.owns_secret = true;
+        state
+    }
+
+    #[inline(always)]
+    fn as_mut_ptr(&mut self) -> *mut ffi::XXH3_state_t {
+        if self.owns_secret {
+            self.inner.secret = self.inner.customSecret.as_ptr() as *const _;
+        }
+
+        &mut self.inner
+    }
+
+    #[inline(always)]
+    fn digest<F, R>(&self, digest: F) -> R
+    where
+        F: FnOnce(*const ffi::XXH3_state_t) -> R,
+    {
+        if self.owns_secret && self.inner.secret != self.inner.customSecret.as_ptr() as *const _ {
+            // moved since the last write
+            let mut state = *self;
+
+            digest(state.as_mut_ptr())
+        } else {
+            digest(&self.inner)
+        }
+    }
+}
+
 /// An implementation of `std::hash::Hasher`.
 ///
 /// # Example
@@ -99,19 +415,51 @@ impl FastHash for Hash64 {
     fn hash<T: AsRef<[u8]>>(bytes: T) -> Self::Hash {
         let bytes = bytes.as_ref();
 
-        unsafe { ffi::XXH3_64bits(bytes.as_ptr() as *const _, bytes.len()) }
+        record_hash!(bytes.len());
+
+        unsafe { ffi::XXH3_64bits_dispatch(bytes.as_ptr() as *const _, bytes.len()) }
     }
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: Self::Seed) -> Self::Hash {
         let bytes = bytes.as_ref();
 
-        unsafe { ffi::XXH3_64bits_withSeed(bytes.as_ptr() as *const _, bytes.len(), seed) }
+        record_hash!(bytes.len());
+
+        unsafe { ffi::XXH3_64bits_withSeed_dispatch(bytes.as_ptr() as *const _, bytes.len(), seed) }
+    }
+
+    #[inline(always)]
+    fn hash_vectored(bufs: &[IoSlice]) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher64::new();
+            h.write_vectored(bufs);
+            h.finish()
+        } else {
+            gather(bufs, |bytes| Self::hash(bytes))
+        }
+    }
+
+    #[inline(always)]
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: Self::Seed) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher64::with_seed(seed);
+            h.write_vectored(bufs);
+            h.finish()
+        } else {
+            gather(bufs, |bytes| Self::hash_with_seed(bytes, seed))
+        }
     }
 }
 
 /// An implementation of `std::hash::Hasher`.
 ///
+/// The XXH3 state is kept inline, so creating a hasher does not allocate.
+///
 /// # Example
 ///
 /// ```
@@ -127,44 +475,69 @@ impl FastHash for Hash64 {
 /// h.write(b"world");
 /// assert_eq!(h.finish(), 5799861518677282342);
 /// ```
-pub struct Hasher64(NonNull<ffi::XXH3_state_t>);
+#[derive(Clone)]
+pub struct Hasher64(State);
 
-impl Default for Hasher64 {
-    fn default() -> Self {
-        Hasher64(unsafe { NonNull::new_unchecked(ffi::XXH3_createState()) })
+impl Hasher64 {
+    /// Constructs a hasher keyed with a custom secret.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use std::hash::Hasher;
+    ///
+    /// use fasthash::xxh3::{self, Hasher64, Secret};
+    ///
+    /// let secret = Secret::generate(b"key");
+    /// let data = vec![1_u8; 1000];
+    /// let mut h = Hasher64::with_secret(&secret);
+    ///
+    /// h.write(&data[..300]);
+    /// h.write(&data[300..]);
+    ///
+    /// assert_eq!(h.finish(), xxh3::hash64_with_secret(&data, &secret));
+    /// ```
+    pub fn with_secret(secret: &Secret) -> Self {
+        Hasher64(State::with_secret(secret, |state, secret, size| unsafe {
+            ffi::XXH3_64bits_reset_withSecret(state, secret, size);
+        }))
     }
-}
-
-impl Clone for Hasher64 {
-    fn clone(&self) -> Self {
-        unsafe {
-            let state = ffi::XXH3_createState();
-
-            ffi::XXH3_copyState(state, self.0.as_ptr());
 
-            Hasher64(NonNull::new_unchecked(state))
-        }
+    #[inline(always)]
+    fn with_static_secret(secret: &'static Secret) -> Self {
+        Hasher64(State::with_static_secret(
+            secret,
+            |state, secret, size| unsafe {
+                ffi::XXH3_64bits_reset_withSecret(state, secret, size);
+            },
+        ))
     }
 }
 
-impl Drop for Hasher64 {
-    fn drop(&mut self) {
-        unsafe {
-            ffi::XXH3_freeState(self.0.as_ptr());
-        }
+impl Default for Hasher64 {
+    #[inline(always)]
+    fn default() -> Self {
+        Hasher64(State::reset(|state| unsafe {
+            ffi::XXH3_64bits_reset(state);
+        }))
     }
 }
 
 impl Hasher for Hasher64 {
     #[inline(always)]
     fn finish(&self) -> u64 {
-        unsafe { ffi::XXH3_64bits_digest(self.0.as_ptr()) }
+        self.0
+            .digest(|state| unsafe { ffi::XXH3_64bits_digest(state) })
     }
 
     #[inline(always)]
     fn write(&mut self, bytes: &[u8]) {
         unsafe {
-            ffi::XXH3_64bits_update(self.0.as_ptr(), bytes.as_ptr() as *const _, bytes.len());
+            ffi::XXH3_64bits_update_dispatch(
+                self.0.as_mut_ptr(),
+                bytes.as_ptr() as *const _,
+                bytes.len(),
+            );
         }
     }
 }
@@ -175,13 +548,9 @@ impl FastHasher for Hasher64 {
 
     #[inline(always)]
     fn with_seed(seed: u64) -> Self {
-        unsafe {
-            let state = ffi::XXH3_createState();
-
+        Hasher64(State::reset(|state| unsafe {
             ffi::XXH3_64bits_reset_withSeed(state, seed);
-
-            Hasher64(NonNull::new_unchecked(state))
-        }
+        }))
     }
 }
 
@@ -218,25 +587,62 @@ impl FastHash for Hash128 {
     fn hash<T: AsRef<[u8]>>(bytes: T) -> Self::Hash {
         let bytes = bytes.as_ref();
 
-        unsafe { mem::transmute(ffi::XXH3_128bits(bytes.as_ptr() as *const _, bytes.len())) }
+        record_hash!(bytes.len());
+
+        unsafe {
+            mem::transmute(ffi::XXH3_128bits_dispatch(
+                bytes.as_ptr() as *const _,
+                bytes.len(),
+            ))
+        }
     }
 
     #[inline(always)]
     fn hash_with_seed<T: AsRef<[u8]>>(bytes: T, seed: Self::Seed) -> Self::Hash {
         let bytes = bytes.as_ref();
 
+        record_hash!(bytes.len());
+
         unsafe {
-            mem::transmute(ffi::XXH3_128bits_withSeed(
+            mem::transmute(ffi::XXH3_128bits_withSeed_dispatch(
                 bytes.as_ptr() as *const _,
                 bytes.len(),
                 seed,
             ))
         }
     }
+
+    #[inline(always)]
+    fn hash_vectored(bufs: &[IoSlice]) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher128::new();
+            h.write_vectored(bufs);
+            h.finish_ext()
+        } else {
+            gather(bufs, |bytes| Self::hash(bytes))
+        }
+    }
+
+    #[inline(always)]
+    fn hash_vectored_with_seed(bufs: &[IoSlice], seed: Self::Seed) -> Self::Hash {
+        if stream_vectored(bufs) {
+            record_hash!(bufs.iter().map(|buf| buf.len()).sum());
+
+            let mut h = Hasher128::with_seed(seed);
+            h.write_vectored(bufs);
+            h.finish_ext()
+        } else {
+            gather(bufs, |bytes| Self::hash_with_seed(bytes, seed))
+        }
+    }
 }
 
 /// An implementation of `std::hash::Hasher`.
 ///
+/// The XXH3 state is kept inline, so creating a hasher does not allocate.
+///
 /// # Example
 ///
 /// ```
@@ -252,44 +658,60 @@ impl FastHash for Hash128 {
 /// h.write(b"world");
 /// assert_eq!(h.finish_ext(), 235571704612606125258077068431826739245);
 /// ```
-pub struct Hasher128(NonNull<ffi::XXH3_state_t>);
-
-impl Default for Hasher128 {
-    fn default() -> Self {
-        Hasher128(unsafe { NonNull::new_unchecked(ffi::XXH3_createState()) })
-    }
-}
-
-impl Clone for Hasher128 {
-    fn clone(&self) -> Self {
-        unsafe {
-            let state = ffi::XXH3_createState();
+#[derive(Clone)]
+pub struct Hasher128(State);
 
-            ffi::XXH3_copyState(state, self.0.as_ptr());
-
-            Hasher128(NonNull::new_unchecked(state))
-        }
+impl Hasher128 {
+    /// Constructs a hasher keyed with a custom secret.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use std::hash::Hasher;
+    ///
+    /// use fasthash::xxh3::{self, Hasher128, Secret};
+    /// use fasthash::HasherExt;
+    ///
+    /// let secret = Secret::generate(b"key");
+    /// let data = vec![1_u8; 1000];
+    /// let mut h = Hasher128::with_secret(&secret);
+    ///
+    /// h.write(&data[..300]);
+    /// h.write(&data[300..]);
+    ///
+    /// assert_eq!(h.finish_ext(), xxh3::hash128_with_secret(&data, &secret));
+    /// ```
+    pub fn with_secret(secret: &Secret) -> Self {
+        Hasher128(State::with_secret(secret, |state, secret, size| unsafe {
+            ffi::XXH3_128bits_reset_withSecret(state, secret, size);
+        }))
     }
 }
 
-impl Drop for Hasher128 {
-    fn drop(&mut self) {
-        unsafe {
-            ffi::XXH3_freeState(self.0.as_ptr());
-        }
+impl Default for Hasher128 {
+    #[inline(always)]
+    fn default() -> Self {
+        Hasher128(State::reset(|state| unsafe {
+            ffi::XXH3_128bits_reset(state);
+        }))
     }
 }
 
 impl Hasher for Hasher128 {
     #[inline(always)]
     fn finish(&self) -> u64 {
-        unsafe { ffi::XXH3_128bits_digest(self.0.as_ptr()).low64 }
+        self.0
+            .digest(|state| unsafe { ffi::XXH3_128bits_digest(state).low64 })
     }
 
     #[inline(always)]
     fn write(&mut self, bytes: &[u8]) {
         unsafe {
-            ffi::XXH3_128bits_update(self.0.as_ptr(), bytes.as_ptr() as *const _, bytes.len());
+            ffi::XXH3_128bits_update_dispatch(
+                self.0.as_mut_ptr(),
+                bytes.as_ptr() as *const _,
+                bytes.len(),
+            );
         }
     }
 }
@@ -297,7 +719,9 @@ impl Hasher for Hasher128 {
 impl HasherExt for Hasher128 {
     #[inline(always)]
     fn finish_ext(&self) -> u128 {
-        let h = unsafe { ffi::XXH3_128bits_digest(self.0.as_ptr()) };
+        let h = self
+            .0
+            .digest(|state| unsafe { ffi::XXH3_128bits_digest(state) });
 
         u128::from(h.low64) + (u128::from(h.high64) << 64)
     }
@@ -309,16 +733,374 @@ impl FastHasher for Hasher128 {
 
     #[inline(always)]
     fn with_seed(seed: u64) -> Self {
-        unsafe {
-            let state = ffi::XXH3_createState();
-
+        Hasher128(State::reset(|state| unsafe {
             ffi::XXH3_128bits_reset_withSeed(state, seed);
-
-            Hasher128(NonNull::new_unchecked(state))
-        }
+        }))
     }
 }
 
 impl StreamHasher for Hasher128 {}
 
 impl_build_hasher!(Hasher128, Hash128);
+
+/// `SecretState` is a `BuildHasher` for `HashMap` or `HashSet` types,
+/// keyed with a secret instead of a seed.
+///
+/// Unlike `RandomState`, it does not derive a new custom secret from a seed
+/// for every long key. `SecretState::new` shares the per-process secret,
+/// so all maps built with it have the same iteration order, and its hashers
+/// refer to that secret instead of copying it.
+///
+/// # Example
+///
+/// ```
+/// use std::collections::HashSet;
+///
+/// use fasthash::xxh3::{Secret, SecretState};
+///
+/// let mut set = HashSet::with_hasher(SecretState::with_secret(Secret::generate(b"key")));
+///
+/// assert!(set.insert(vec![0_u8; 4096]));
+/// assert!(!set.insert(vec![0_u8; 4096]));
+/// ```
+#[derive(Clone)]
+pub struct SecretState(StateSecret);
+
+#[derive(Clone)]
+enum StateSecret {
+    Process(&'static Secret),
+    Owned(Secret),
+}
+
+impl SecretState {
+    /// Constructs a `SecretState` keyed with the per-process secret.
+    #[inline(always)]
+    pub fn new() -> Self {
+        SecretState(StateSecret::Process(Secret::process()))
+    }
+
+    /// Constructs a `SecretState` keyed with the given secret.
+    #[inline(always)]
+    pub fn with_secret(secret: Secret) -> Self {
+        SecretState(StateSecret::Owned(secret))
+    }
+}
+
+impl Default for SecretState {
+    #[inline(always)]
+    fn default() -> Self {
+        SecretState::new()
+    }
+}
+
+impl BuildHasher for SecretState {
+    type Hasher = Hasher64;
+
+    #[inline(always)]
+    fn build_hasher(&self) -> Hasher64 {
+        match self.0 {
+            StateSecret::Process(secret) => Hasher64::with_static_secret(secret),
+            StateSecret::Owned(ref secret) => Hasher64::with_secret(secret),
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_dispatch_matches_default_kernel() {
+        let data = (0..64 * 1024_u32)
+            .map(|i| (i * 31 >> 3) as u8)
+            .collect::<Vec<_>>();
+
+        for &len in &[0, 1, 16, 128, 240, 241, 1024, 1025, 4096, 10_000, 64 * 1024] {
+            let bytes = &data[..len];
+            let (p, n) = (bytes.as_ptr() as *const _, bytes.len());
+
+            unsafe {
+                assert_eq!(hash64(bytes), ffi::XXH3_64bits(p, n));
+                assert_eq!(
+                    hash64_with_seed(bytes, 42),
+                    ffi::XXH3_64bits_withSeed(p, n, 42)
+                );
+
+                let h = ffi::XXH3_128bits_withSeed(p, n, 42);
+
+                assert_eq!(
+                    hash128_with_seed(bytes, 42),
+                    u128::from(h.low64) + (u128::from(h.high64) << 64)
+                );
+            }
+
+            let mut h = Hasher64::new();
+
+            for chunk in bytes.chunks(1000) {
+                h.write(chunk);
+            }
+
+            assert_eq!(h.finish(), hash64(bytes));
+        }
+    }
+
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    #[test]
+    fn test_kernels_match_scalar() {
+        use ffi::XXH3_kernel_XXH3_KERNEL_SCALAR as SCALAR;
+
+        let kernels = [
+            ffi::XXH3_kernel_XXH3_KERNEL_SSE2,
+            ffi::XXH3_kernel_XXH3_KERNEL_AVX2,
+        ];
+        let data = (0..64 * 1024_u32)
+            .map(|i| (i * 31 >> 3) as u8)
+            .collect::<Vec<_>>();
+        let secret = Secret::generate(b"kernel");
+        let (s, sn) = (secret.0.as_ptr() as *const _, SECRET_SIZE);
+
+        let to_u128 = |h: ffi::XXH128_hash_t| u128::from(h.low64) + (u128::from(h.high64) << 64);
+        let stream64 = |kernel, bytes: &[u8]| {
+            let mut state = State::reset(|state| unsafe {
+                ffi::XXH3_64bits_reset_withSeed(state, 42);
+            });
+
+            for chunk in bytes.chunks(1000) {
+                unsafe {
+                    ffi::XXH3_64bits_update_kernel(
+                        kernel,
+                        state.as_mut_ptr(),
+                        chunk.as_ptr() as *const _,
+                        chunk.len(),
+                    );
+                }
+            }
+
+            state.digest(|state| unsafe { ffi::XXH3_64bits_digest(state) })
+        };
+        let stream128 = |kernel, bytes: &[u8]| {
+            let mut state = State::reset(|state| unsafe {
+                ffi::XXH3_128bits_reset_withSeed(state, 42);
+            });
+
+            for chunk in bytes.chunks(1000) {
+                unsafe {
+                    ffi::XXH3_128bits_update_kernel(
+                        kernel,
+                        state.as_mut_ptr(),
+                        chunk.as_ptr() as *const _,
+                        chunk.len(),
+                    );
+                }
+            }
+
+            to_u128(state.digest(|state| unsafe { ffi::XXH3_128bits_digest(state) }))
+        };
+
+        assert!(unsafe { ffi::XXH3_kernel_supported(SCALAR) });
+
+        for &kernel in &kernels {
+            if !unsafe { ffi::XXH3_kernel_supported(kernel) } {
+                continue;
+            }
+
+            for &len in &[0, 1, 16, 128, 240, 241, 1024, 1025, 4096, 10_000, 64 * 1024] {
+                let bytes = &data[..len];
+                let (p, n) = (bytes.as_ptr() as *const _, bytes.len());
+
+                unsafe {
+                    assert_eq!(
+                        ffi::XXH3_64bits_withSeed_kernel(kernel, p, n, 42),
+                        ffi::XXH3_64bits_withSeed_kernel(SCALAR, p, n, 42),
+                        "kernel {}, {} bytes",
+                        kernel,
+                        len
+                    );
+                    assert_eq!(
+                        ffi::XXH3_64bits_withSecret_kernel(kernel, p, n, s, sn),
+                        ffi::XXH3_64bits_withSecret_kernel(SCALAR, p, n, s, sn),
+                        "kernel {}, {} bytes",
+                        kernel,
+                        len
+                    );
+                    assert_eq!(
+                        to_u128(ffi::XXH3_128bits_withSeed_kernel(kernel, p, n, 42)),
+                        to_u128(ffi::XXH3_128bits_withSeed_kernel(SCALAR, p, n, 42)),
+                        "kernel {}, {} bytes",
+                        kernel,
+                        len
+                    );
+                    assert_eq!(
+                        to_u128(ffi::XXH3_128bits_withSecret_kernel(kernel, p, n, s, sn)),
+                        to_u128(ffi::XXH3_128bits_withSecret_kernel(SCALAR, p, n, s, sn)),
+                        "kernel {}, {} bytes",
+                        kernel,
+                        len
+                    );
+                }
+
+                assert_eq!(
+                    stream64(kernel, bytes),
+                    stream64(SCALAR, bytes),
+                    "kernel {}, {} bytes",
+                    kernel,
+                    len
+                );
+                assert_eq!(
+                    stream128(kernel, bytes),
+                    stream128(SCALAR, bytes),
+                    "kernel {}, {} bytes",
+                    kernel,
+                    len
+                );
+            }
+        }
+    }
+
+    fn check_hash_array<const N: usize>() {
+        let mut key = [0_u8; N];
+
+        for (i, b) in key.iter_mut().enumerate() {
+            *b = (i * 31) as u8;
+        }
+
+        assert_eq!(hash_array(&key), hash64(&key[..]), "N = {}", N);
+        assert_eq!(
+            hash_array_with_seed(&key, 42),
+            hash64_with_seed(&key[..], 42),
+            "N = {}",
+            N
+        );
+    }
+
+    #[test]
+    fn test_hash_array_matches_slice() {
+        check_hash_array::<4>();
+        check_hash_array::<8>();
+        check_hash_array::<12>();
+        check_hash_array::<16>();
+        check_hash_array::<20>();
+        check_hash_array::<24>();
+        check_hash_array::<32>();
+        check_hash_array::<64>();
+        check_hash_array::<7>();
+    }
+
+    #[test]
+    fn test_secret_streaming() {
+        let secret = Secret::generate(b"secret");
+        let data = (0..10_000_u32).map(|i| i as u8).collect::<Vec<_>>();
+
+        for &len in &[0, 100, 240, 241, 1000, 10_000] {
+            let bytes = &data[..len];
+            let mut h64 = Hasher64::with_secret(&secret);
+            let mut h128 = Hasher128::with_secret(&secret);
+
+            h64.write(bytes);
+            h128.write(bytes);
+
+            assert_eq!(h64.finish(), hash64_with_secret(bytes, &secret));
+            assert_eq!(h128.finish_ext(), hash128_with_secret(bytes, &secret));
+        }
+    }
+
+    #[test]
+    fn test_clone_owns_secret() {
+        let data = vec![7_u8; 5000];
+        let secret = Secret::generate(b"secret");
+        let mut keyed = Hasher64::with_secret(&secret);
+        let mut seeded = Hasher64::with_seed(42);
+
+        keyed.write(&data[..1000]);
+        seeded.write(&data[..1000]);
+
+        let (mut keyed2, mut seeded2) = (keyed.clone(), seeded.clone());
+
+        drop((keyed, seeded));
+
+        keyed2.write(&data[1000..]);
+        seeded2.write(&data[1000..]);
+
+        assert_eq!(keyed2.finish(), hash64_with_secret(&data, &secret));
+        assert_eq!(seeded2.finish(), hash64_with_seed(&data, 42));
+    }
+
+    #[test]
+    fn test_moved_state() {
+        let data = vec![3_u8; 3000];
+        let secret = Secret::generate(b"secret");
+        let mut hashers = Vec::new();
+
+        for seed in 0..4 {
+            let mut h = Hasher128::with_seed(seed);
+
+            h.write(&data[..1000]);
+            hashers.push((seed, h));
+        }
+
+        let mut keyed = Box::new(Hasher64::with_secret(&secret));
+
+        keyed.write(&data[..1000]);
+
+        let mut keyed = *keyed;
+
+        for (seed, h) in &mut hashers {
+            h.write(&data[1000..]);
+
+            assert_eq!(h.finish_ext(), hash128_with_seed(&data, *seed));
+        }
+
+        assert_eq!(keyed.clone().finish(), {
+            keyed.write(&data[1000..]);
+            hash64_with_secret(&data[..1000], &secret)
+        });
+        assert_eq!(keyed.finish(), hash64_with_secret(&data, &secret));
+        assert_eq!(Hasher64::default().finish(), hash64(b""));
+    }
+
+    #[test]
+    fn test_hash_vectored_matches_concat() {
+        let data = (0..8192_u32)
+            .map(|i| (i * 7 >> 2) as u8)
+            .collect::<Vec<_>>();
+
+        for &len in &[0, 100, 1023, 1024, 5000, 8192] {
+            let (a, rest) = data[..len].split_at(len / 3);
+            let (b, c) = rest.split_at(rest.len() / 2);
+            let bufs = [IoSlice::new(a), IoSlice::new(b), IoSlice::new(c)];
+
+            assert_eq!(Hash64::hash_vectored(&bufs), Hash64::hash(&data[..len]));
+            assert_eq!(
+                Hash64::hash_vectored_with_seed(&bufs, 123),
+                Hash64::hash_with_seed(&data[..len], 123)
+            );
+            assert_eq!(Hash128::hash_vectored(&bufs), Hash128::hash(&data[..len]));
+
+            let mut h = Hasher64::new();
+            h.write_vectored(&bufs);
+            assert_eq!(h.finish(), Hash64::hash(&data[..len]));
+        }
+    }
+
+    #[test]
+    fn test_process_secret_state() {
+        let data = vec![5_u8; 3000];
+        let state = SecretState::new();
+        let mut h = state.build_hasher();
+
+        assert!(!h.0.owns_secret);
+
+        h.write(&data[..1000]);
+
+        let mut moved = vec![h.clone()];
+
+        drop(h);
+
+        moved[0].write(&data[1000..]);
+
+        assert_eq!(
+            moved[0].finish(),
+            hash64_with_secret(&data, Secret::process())
+        );
+    }
+}